@@ -1,182 +1,208 @@
 #include "cppstring.h"
 
-String::String() : size_(0), capacity_(0), string_(nullptr) {
+#include <charconv>
+#include <functional>
+#include <limits>
+
+#include "../cstring/cstring.h"
+
+bool String::IsLong() const noexcept {
+  return (static_cast<unsigned char>(short_[kShortCapacity]) & 0x80) != 0;
 }
 
-void TransferArray(char* array1, const char* array2, size_t size) {
-  for (size_t i = 0; i < size; ++i) {
-    array1[i] = array2[i];
-  }
+char* String::Pointer() noexcept {
+  InvalidateHash();
+  return (IsLong() ? long_.data : short_);
 }
 
-String::String(const char* string, size_t size) : size_(size), capacity_(size), string_(nullptr) {
-  if (!Empty()) {
-    string_ = new char[capacity_ + 1];
-    TransferArray(string_, string, size);
-    string_[size_] = '\0';
-  }
+const char* String::Pointer() const noexcept {
+  return (IsLong() ? long_.data : short_);
 }
 
-void String::Reserve(size_t new_capacity) {
-  if (capacity_ < new_capacity) {
-    capacity_ = new_capacity;
-    auto string_temp = new char[capacity_ + 1];
-    TransferArray(string_temp, string_, size_);
-    string_temp[size_] = '\0';
-    delete[] string_;
-    string_ = string_temp;
-  }
+void String::InitShort() noexcept {
+  InvalidateHash();
+  short_[0] = '\0';
+  short_[kShortCapacity] = static_cast<char>(kShortCapacity);
 }
 
-String::String(const size_t size, const char symbol) : size_(size), capacity_(size), string_(nullptr) {
-  if (!Empty()) {
-    string_ = new char[capacity_ + 1];
-    for (size_t i = 0; i < size; ++i) {
-      string_[i] = symbol;
-    }
-    string_[size_] = '\0';
+void String::InitFrom(const char* string, size_t size) {
+  if (size <= kShortCapacity) {
+    InitShort();
+  } else {
+    long_.data = new char[size + 1];
+    SetLongCapacity(size);
   }
+  Memcpy(Pointer(), string, size);
+  SetSize(size);
 }
 
-String::String(const char* string) : size_(0), capacity_(0) {
-  if (string[0] == '\0') {
-    string_ = nullptr;
+void String::SetSize(size_t size) noexcept {
+  InvalidateHash();
+  if (IsLong()) {
+    long_.size = size;
+    long_.data[size] = '\0';
   } else {
-    capacity_ = 1;
-    string_ = new char[capacity_ + 1];
-    while (string[size_] != '\0') {
-      if (size_ < capacity_) {
-        string_[size_] = string[size_];
-      } else {
-        Reserve(2 * capacity_);
-        string_[size_] = string[size_];
-      }
-      ++size_;
+    short_[size] = '\0';
+    short_[kShortCapacity] = static_cast<char>(kShortCapacity - size);
+  }
+}
+
+void String::SetLongCapacity(size_t capacity) noexcept {
+  long_.capacity = (capacity << kCapacityShift) | kLongFlag;
+}
+
+String::String() {
+  InitShort();
+}
+
+String::String(const char* string, size_t size) {
+  InitFrom(string, size);
+}
+
+String::String(StringView view) {
+  InitFrom(view.Data(), view.Size());
+}
+
+void String::Reserve(size_t new_capacity) {
+  if (Capacity() < new_capacity) {
+    size_t size = Size();
+    auto string_temp = new char[new_capacity + 1];
+    Memcpy(string_temp, Pointer(), size + 1);
+    if (IsLong()) {
+      delete[] long_.data;
     }
-    string_[size_] = '\0';
+    long_.data = string_temp;
+    long_.size = size;
+    SetLongCapacity(new_capacity);
   }
 }
 
+String::String(const size_t size, const char symbol) {
+  InitShort();
+  Resize(size, symbol);
+}
+
+String::String(const char* string) {
+  InitFrom(string, Strlen(string));
+}
+
 String::~String() {
-  delete[] string_;
+  if (IsLong()) {
+    delete[] long_.data;
+  }
 }
 
-String::String(const String& other) : size_(other.size_), capacity_(other.capacity_), string_(other.string_) {
-  if (capacity_ != 0) {
-    string_ = new char[capacity_ + 1];
-    TransferArray(string_, other.string_, size_ + 1);
+String::String(const String& other) {
+  if (other.IsLong()) {
+    InitFrom(other.long_.data, other.long_.size);
+  } else {
+    Memcpy(short_, other.short_, sizeof(short_));
   }
 }
 
 String& String::operator=(const String& other) {
   if (&other != this) {
-    delete[] string_;
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    if (capacity_ == 0) {
-      string_ = nullptr;
-    } else {
-      string_ = new char[capacity_ + 1];
-      TransferArray(string_, other.string_, size_ + 1);
-    }
+    String copy = other;
+    *this = std::move(copy);
   }
   return *this;
 }
 
-String::String(String&& other) noexcept : size_(other.size_), capacity_(other.capacity_), string_(other.string_) {
-  other.string_ = nullptr;
-  other.size_ = 0;
-  other.capacity_ = 0;
+String::String(String&& other) noexcept {
+  Memcpy(short_, other.short_, sizeof(short_));
+  other.InitShort();
 }
 
 String& String::operator=(String&& other) noexcept {
   if (&other != this) {
-    delete[] string_;
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    string_ = other.string_;
-    other.string_ = nullptr;
-    other.size_ = 0;
-    other.capacity_ = 0;
+    if (IsLong()) {
+      delete[] long_.data;
+    }
+    Memcpy(short_, other.short_, sizeof(short_));
+    InvalidateHash();
+    other.InitShort();
   }
   return *this;
 }
 
 char& String::operator[](size_t index) {
-  return string_[index];
+  return Pointer()[index];
 }
 
 const char& String::operator[](size_t index) const {
-  return string_[index];
+  return Pointer()[index];
 }
 
 char& String::At(size_t index) {
-  if (index >= size_) {
+  if (index >= Size()) {
     throw StringOutOfRange{};
   }
-  return string_[index];
+  return Pointer()[index];
 }
 
 const char& String::At(size_t index) const {
-  if (index >= size_) {
+  if (index >= Size()) {
     throw StringOutOfRange{};
   }
-  return string_[index];
+  return Pointer()[index];
 }
 
 char& String::Front() {
-  return string_[0];
+  return Pointer()[0];
 }
 
 const char& String::Front() const {
-  return string_[0];
+  return Pointer()[0];
 }
 
 char& String::Back() {
-  return string_[size_ - 1];
+  return Pointer()[Size() - 1];
 }
 
 const char& String::Back() const {
-  return string_[size_ - 1];
+  return Pointer()[Size() - 1];
 }
 
 const char* String::CStr() const {
-  return string_;
+  return Pointer();
 }
 
 char* String::Data() {
-  return string_;
+  return Pointer();
 }
 
 char* String::CStr() {
-  return string_;
+  return Pointer();
 }
 
 const char* String::Data() const {
-  return string_;
+  return Pointer();
 }
 
 bool String::Empty() const {
-  return (size_ == 0);
+  return (Size() == 0);
 }
 
 size_t String::Size() const {
-  return size_;
+  if (IsLong()) {
+    return long_.size;
+  }
+  return kShortCapacity - static_cast<unsigned char>(short_[kShortCapacity]);
 }
 
 size_t String::Length() const {
-  return size_;
+  return Size();
 }
 
 size_t String::Capacity() const {
-  return capacity_;
+  if (IsLong()) {
+    return (long_.capacity & ~kLongFlag) >> kCapacityShift;
+  }
+  return kShortCapacity;
 }
 
 void String::Clear() {
-  if (!Empty()) {
-    size_ = 0;
-    string_[0] = '\0';
-  }
+  SetSize(0);
 }
 
 void String::Swap(String& other) {
@@ -187,83 +213,99 @@ void String::Swap(String& other) {
 
 void String::PopBack() {
   if (!Empty()) {
-    --size_;
-    string_[size_] = '\0';
+    SetSize(Size() - 1);
   }
 }
 
 void String::PushBack(const char symbol) {
-  if (capacity_ == 0) {
-    capacity_ = 1;
-    string_ = new char[capacity_ + 1];
-  }
-  if (size_ == capacity_) {
-    Reserve(2 * capacity_);
-    string_[size_++] = symbol;
-  } else {
-    string_[size_++] = symbol;
+  size_t size = Size();
+  if (size == Capacity()) {
+    Reserve(2 * size);
   }
-  string_[size_] = '\0';
+  Pointer()[size] = symbol;
+  SetSize(size + 1);
 }
 
 String& String::operator+=(const String& other) {
-  if (!other.Empty()) {
-    if (other.size_ + size_ > capacity_) {
-      Reserve(2 * (other.size_ + size_));
+  return *this += StringView(other);
+}
+
+// A view into this string stays valid across Reserve because the source is read through its
+// offset from the old buffer.
+String& String::operator+=(StringView other) {
+  size_t size = Size();
+  size_t other_size = other.Size();
+  if (other_size != 0) {
+    const char* source = other.Data();
+    if (size + other_size > Capacity()) {
+      std::less<const char*> less;
+      bool aliases = !less(source, Pointer()) && less(source, Pointer() + size);
+      size_t offset = (aliases ? source - Pointer() : 0);
+      Reserve(2 * (size + other_size));
+      if (aliases) {
+        source = Pointer() + offset;
+      }
     }
-    size_t prev_size = size_;
-    size_ += other.size_;
-    TransferArray(string_ + prev_size, other.string_, other.size_ + 1);
+    Memcpy(Pointer() + size, source, other_size);
+    SetSize(size + other_size);
   }
   return *this;
 }
 
+String& String::operator+=(const char* other) {
+  return *this += StringView(other);
+}
+
+String::operator StringView() const noexcept {
+  return StringView(Pointer(), Size());
+}
+
+void String::InvalidateHash() noexcept {
+#ifdef STRING_CACHED_HASH
+  hash_ = 0;
+#endif
+}
+
+uint64_t String::Hash() const noexcept {
+#ifdef STRING_CACHED_HASH
+  if (hash_ == 0) {
+    hash_ = HashBytes(Pointer(), Size());
+  }
+  return hash_;
+#else
+  return HashBytes(Pointer(), Size());
+#endif
+}
+
 void String::Resize(size_t new_size, char symbol) {
-  if (new_size > capacity_) {
+  if (new_size > Capacity()) {
     Reserve(new_size);
   }
-  if (size_ < new_size) {
-    for (size_t i = size_; i < new_size; ++i) {
-      string_[i] = symbol;
-    }
-    string_[new_size] = '\0';
-    size_ = new_size;
-  }
-  if ((size_ > new_size) && (capacity_ != 0)) {
-    size_ = new_size;
-    string_[size_] = '\0';
+  char* string = Pointer();
+  for (size_t i = Size(); i < new_size; ++i) {
+    string[i] = symbol;
   }
+  SetSize(new_size);
 }
 
 void String::ShrinkToFit() {
-  if (Empty()) {
-    delete[] string_;
-    capacity_ = 0;
-    string_ = nullptr;
-  } else {
-    capacity_ = size_;
-    auto string_temp = new char[capacity_ + 1];
-    TransferArray(string_temp, string_, size_);
-    delete[] string_;
-    string_ = string_temp;
-    string_[size_] = '\0';
+  if (!IsLong() || Capacity() == Size()) {
+    return;
   }
+  String shrunk(long_.data, long_.size);
+  *this = std::move(shrunk);
 }
 
 String operator+(const String& string1, const String& string2) {
-  String result = string1;
+  String result;
+  result.Reserve(string1.Size() + string2.Size());
+  result += string1;
   result += string2;
   return result;
 }
 
 bool operator<(const String& string1, const String& string2) {
-  size_t min_size = std::min(string1.size_, string2.size_);
-  for (size_t i = 0; i < min_size; ++i) {
-    if (string1[i] != string2[i]) {
-      return string1[i] < string2[i];
-    }
-  }
-  return string1.Size() < string2.Size();
+  return StringView(string1) < StringView(string2);
 }
 
 bool operator>=(const String& string1, const String& string2) {
@@ -271,7 +313,7 @@ bool operator>=(const String& string1, const String& string2) {
 }
 
 bool operator==(const String& string1, const String& string2) {
-  return !(string1 < string2) && !(string2 < string1);
+  return StringView(string1) == StringView(string2);
 }
 
 bool operator<=(const String& string1, const String& string2) {
@@ -286,9 +328,106 @@ bool operator!=(const String& string1, const String& string2) {
   return !(string1 == string2);
 }
 
-std::ostream& operator<<(std::ostream& os, const String& string) {
-  if (string.string_ != nullptr) {
-    os << string.string_;
+namespace {
+constexpr char kDigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Value of eight ASCII digits loaded little-endian, or -1 if any byte is not a digit.
+int64_t ParseEightDigits(const char* digits) {
+  uint64_t word;
+  Memcpy(reinterpret_cast<char*>(&word), digits, sizeof(word));
+  if (((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) !=
+      0x3333333333333333ULL) {
+    return -1;
+  }
+  word = ((word & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+  word = ((word & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+  return static_cast<int64_t>(((word & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+}
+}  // namespace
+
+bool String::ParseInt(int64_t* value) const noexcept {
+  const char* current = Pointer();
+  const char* end = current + Size();
+  bool negative = (current != end && *current == '-');
+  current += negative;
+  if (current == end) {
+    return false;
+  }
+  while (end - current > 1 && *current == '0') {
+    ++current;
+  }
+  // At most 19 significant digits, which cannot overflow uint64_t.
+  if (end - current > std::numeric_limits<int64_t>::digits10 + 1) {
+    return false;
   }
+  uint64_t result = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; end - current >= 8; current += 8) {
+    int64_t eight = ParseEightDigits(current);
+    if (eight < 0) {
+      return false;
+    }
+    result = result * 100000000 + static_cast<uint64_t>(eight);
+  }
+#endif
+  for (; current != end; ++current) {
+    auto digit = static_cast<unsigned>(*current - '0');
+    if (digit > 9) {
+      return false;
+    }
+    result = result * 10 + digit;
+  }
+  auto limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + negative;
+  if (result > limit) {
+    return false;
+  }
+  *value = static_cast<int64_t>(negative ? 0 - result : result);
+  return true;
+}
+
+bool String::ParseDouble(double* value) const noexcept {
+  const char* end = Pointer() + Size();
+  double result;
+  auto [parsed_end, error] = std::from_chars(Pointer(), end, result);
+  if (error != std::errc() || parsed_end != end) {
+    return false;
+  }
+  *value = result;
+  return true;
+}
+
+// Digits are produced two at a time from the end of a stack buffer.
+String& String::AppendInt(int64_t value) {
+  char buffer[20];
+  char* begin = buffer + sizeof(buffer);
+  uint64_t magnitude = (value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value));
+  while (magnitude >= 100) {
+    begin -= 2;
+    Memcpy(begin, kDigitPairs + 2 * (magnitude % 100), 2);
+    magnitude /= 100;
+  }
+  if (magnitude >= 10) {
+    begin -= 2;
+    Memcpy(begin, kDigitPairs + 2 * magnitude, 2);
+  } else {
+    *--begin = static_cast<char>('0' + magnitude);
+  }
+  if (value < 0) {
+    *--begin = '-';
+  }
+  return *this += StringView(begin, buffer + sizeof(buffer) - begin);
+}
+
+String& String::AppendDouble(double value) {
+  char buffer[32];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  return *this += StringView(buffer, result.ptr - buffer);
+}
+
+std::ostream& operator<<(std::ostream& os, const String& string) {
+  os << string.CStr();
   return os;
-}
\ No newline at end of file
+}
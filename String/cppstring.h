@@ -2,8 +2,13 @@
 #define CPPSTRING_
 
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
+#include <type_traits>
+
+#include "../hash.h"
+#include "string_view.h"
 
 class StringOutOfRange : public std::out_of_range {
  public:
@@ -13,15 +18,49 @@ class StringOutOfRange : public std::out_of_range {
 
 class String {
  private:
-  size_t size_;
-  size_t capacity_;
-  char* string_;
+  struct LongString {
+    char* data;
+    size_t size;
+    size_t capacity;
+  };
+  static constexpr size_t kShortCapacity = sizeof(LongString) - 1;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  static constexpr size_t kCapacityShift = 8;
+  static constexpr size_t kLongFlag = 0x80;
+#else
+  static constexpr size_t kCapacityShift = 0;
+  static constexpr size_t kLongFlag = size_t(1) << (8 * sizeof(size_t) - 1);
+#endif
+  // Strings of up to kShortCapacity chars live inline. The last byte of short_ holds
+  // kShortCapacity - size, so it is also the terminator of a full inline string; a heap string
+  // sets the high bit of that byte through kLongFlag in its capacity word.
+  union {
+    LongString long_;
+    char short_[sizeof(LongString)];
+  };
+#ifdef STRING_CACHED_HASH
+  // Set only through the STRINGS_CACHED_HASH CMake option, never per translation unit: it changes
+  // the layout of String. Zero means not computed. Every mutator, and every accessor that hands out
+  // a mutable pointer or reference, clears it. Writing through such a pointer or reference after a
+  // later Hash() call is unsupported and leaves the cached hash stale.
+  mutable uint64_t hash_ = 0;
+#endif
+  void InvalidateHash() noexcept;
+  bool IsLong() const noexcept;
+  char* Pointer() noexcept;
+  const char* Pointer() const noexcept;
+  void InitShort() noexcept;
+  void InitFrom(const char*, size_t);
+  void SetSize(size_t) noexcept;
+  void SetLongCapacity(size_t) noexcept;
 
  public:
+  using TriviallyRelocatable = std::true_type;
   String();
   String(const size_t, const char);
   String(const char*);  // NOLINT
   String(const char*, size_t);
+  explicit String(StringView);
   String(const String& other);
   String(String&&) noexcept;
   String& operator=(String&&) noexcept;
@@ -48,6 +87,17 @@ class String {
   void PopBack();
   void PushBack(const char symbol);
   String& operator+=(const String& other);
+  String& operator+=(StringView);
+  String& operator+=(const char*);
+  operator StringView() const noexcept;  // NOLINT
+  uint64_t Hash() const noexcept;
+  // The whole string must be the number: an optional '-' and decimal digits for ParseInt, the
+  // std::from_chars general format for ParseDouble. On failure or overflow *value is unchanged.
+  bool ParseInt(int64_t* value) const noexcept;
+  bool ParseDouble(double* value) const noexcept;
+  String& AppendInt(int64_t);
+  // Shortest representation that parses back to the same double.
+  String& AppendDouble(double);
   void Resize(size_t new_size, char symbol);
   void Reserve(size_t new_capacity);
   void ShrinkToFit();
@@ -61,4 +111,11 @@ bool operator!=(const String&, const String&);
 bool operator>(const String&, const String&);
 bool operator>=(const String&, const String&);
 bool operator<=(const String&, const String&);
+
+template <>
+struct std::hash<String> {
+  size_t operator()(const String& string) const noexcept {
+    return static_cast<size_t>(string.Hash());
+  }
+};
 #endif
\ No newline at end of file
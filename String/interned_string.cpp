@@ -0,0 +1,81 @@
+#include "interned_string.h"
+
+#include <mutex>
+
+// Folds the high half of the hash into the low bits, which the shard's own buckets also use.
+size_t InternTable::ShardIndex(size_t hash) noexcept {
+  return (hash ^ (hash >> (sizeof(size_t) * 4))) % kShardCount;
+}
+
+const String* InternTable::Intern(StringView view) {
+  Key key{view, view.Hash()};
+  Shard& shard = shards_[ShardIndex(key.hash)];
+  {
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+      return it->second;
+    }
+  }
+  std::unique_lock lock(shard.mutex);
+  auto it = shard.index.find(key);
+  if (it != shard.index.end()) {
+    return it->second;
+  }
+  UniquePtr<String> entry(new String(view));
+  const String* result = entry.Get();
+  shard.strings.PushBack(std::move(entry));
+  shard.index.emplace(Key{StringView(*result), key.hash}, result);
+  return result;
+}
+
+size_t InternTable::Size() {
+  size_t size = 0;
+  for (auto& shard : shards_) {
+    std::shared_lock lock(shard.mutex);
+    size += shard.index.size();
+  }
+  return size;
+}
+
+// Never destroyed, so handles held by other static objects stay valid during exit.
+InternTable& InternTable::Global() {
+  static InternTable* table = new InternTable;
+  return *table;
+}
+
+InternedString::InternedString(StringView view)
+    : string_(view.Empty() ? nullptr : InternTable::Global().Intern(view)) {
+}
+
+const char* InternedString::Data() const noexcept {
+  return (string_ == nullptr ? "" : string_->Data());
+}
+
+const char* InternedString::CStr() const noexcept {
+  return Data();
+}
+
+size_t InternedString::Size() const noexcept {
+  return (string_ == nullptr ? 0 : string_->Size());
+}
+
+bool InternedString::Empty() const noexcept {
+  return (string_ == nullptr);
+}
+
+InternedString::operator StringView() const noexcept {
+  return StringView(Data(), Size());
+}
+
+bool operator==(InternedString string1, InternedString string2) noexcept {
+  return string1.string_ == string2.string_;
+}
+
+bool operator!=(InternedString string1, InternedString string2) noexcept {
+  return !(string1 == string2);
+}
+
+bool operator<(InternedString string1, InternedString string2) {
+  return StringView(string1) < StringView(string2);
+}
@@ -0,0 +1,79 @@
+#ifndef INTERNED_STRING_H_
+#define INTERNED_STRING_H_
+
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "../unique_ptr.h"
+#include "../vector.h"
+#include "cppstring.h"
+
+// Set of distinct strings that are never freed, so a pointer to an entry identifies its contents.
+// Lookups take a shared lock on one of kShardCount shards; only first insertions take it
+// exclusively.
+class InternTable {
+ private:
+  static constexpr size_t kShardCount = 16;
+  // The hash is computed once per Intern() call and carried in the key, so the map never rehashes
+  // the text.
+  struct Key {
+    StringView view;
+    size_t hash;
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const noexcept {
+      return key.hash;
+    }
+  };
+  struct KeyEqual {
+    bool operator()(const Key& key1, const Key& key2) const noexcept {
+      return key1.hash == key2.hash && key1.view == key2.view;
+    }
+  };
+  struct Shard {
+    std::shared_mutex mutex;
+    std::unordered_map<Key, const String*, KeyHash, KeyEqual> index;
+    Vector<UniquePtr<String>> strings;
+  };
+  Shard shards_[kShardCount];
+  static size_t ShardIndex(size_t hash) noexcept;
+
+ public:
+  InternTable() = default;
+  InternTable(const InternTable&) = delete;
+  InternTable& operator=(const InternTable&) = delete;
+  const String* Intern(StringView);
+  size_t Size();
+  static InternTable& Global();
+};
+
+// Handle to a string in the global InternTable. Copies are pointer copies, and two handles are
+// equal exactly when their pointers are.
+class InternedString {
+ private:
+  const String* string_;
+
+ public:
+  InternedString() noexcept : string_(nullptr) {
+  }
+  explicit InternedString(StringView);
+
+  const char* Data() const noexcept;
+  const char* CStr() const noexcept;
+  size_t Size() const noexcept;
+  bool Empty() const noexcept;
+  operator StringView() const noexcept;  // NOLINT
+  friend bool operator==(InternedString, InternedString) noexcept;
+  friend struct std::hash<InternedString>;
+};
+
+bool operator!=(InternedString, InternedString) noexcept;
+bool operator<(InternedString, InternedString);
+
+template <>
+struct std::hash<InternedString> {
+  size_t operator()(InternedString string) const noexcept {
+    return std::hash<const String*>()(string.string_);
+  }
+};
+#endif
@@ -0,0 +1,211 @@
+#include "rope.h"
+
+#include <algorithm>
+
+Rope::NodePtr Rope::MakeLeaf(std::shared_ptr<const String> text, size_t offset, size_t size) {
+  return std::make_shared<const Node>(Node{size, 0, nullptr, nullptr, std::move(text), offset});
+}
+
+Rope::NodePtr Rope::MakeLeaf(StringView first, StringView second) {
+  String text;
+  text.Reserve(first.Size() + second.Size());
+  text += first;
+  text += second;
+  size_t size = text.Size();
+  return MakeLeaf(std::make_shared<const String>(std::move(text)), 0, size);
+}
+
+Rope::NodePtr Rope::MakeConcat(NodePtr left, NodePtr right) {
+  size_t size = left->size + right->size;
+  size_t depth = std::max(left->depth, right->depth) + 1;
+  return std::make_shared<const Node>(Node{size, depth, std::move(left), std::move(right), nullptr, 0});
+}
+
+StringView Rope::LeafView(const Node& node) noexcept {
+  return StringView(node.text->Data() + node.offset, node.size);
+}
+
+Rope::NodePtr Rope::RotateLeft(const NodePtr& node) {
+  const NodePtr& right = node->right;
+  return MakeConcat(MakeConcat(node->left, right->left), right->right);
+}
+
+Rope::NodePtr Rope::RotateRight(const NodePtr& node) {
+  const NodePtr& left = node->left;
+  return MakeConcat(left->left, MakeConcat(left->right, node->right));
+}
+
+// AVL join for left->depth > right->depth + 1: walks down the right spine of left to a subtree
+// about as deep as right, links them there and restores balance on the way back up.
+Rope::NodePtr Rope::JoinRight(const NodePtr& left, const NodePtr& right) {
+  const NodePtr& outer = left->left;
+  const NodePtr& inner = left->right;
+  if (inner->depth <= right->depth + 1) {
+    NodePtr joined = MakeConcat(inner, right);
+    if (joined->depth <= outer->depth + 1) {
+      return MakeConcat(outer, std::move(joined));
+    }
+    return RotateLeft(MakeConcat(outer, RotateRight(joined)));
+  }
+  NodePtr joined = JoinRight(inner, right);
+  bool balanced = joined->depth <= outer->depth + 1;
+  NodePtr result = MakeConcat(outer, std::move(joined));
+  return (balanced ? result : RotateLeft(result));
+}
+
+// Mirror image of JoinRight for right->depth > left->depth + 1.
+Rope::NodePtr Rope::JoinLeft(const NodePtr& left, const NodePtr& right) {
+  const NodePtr& inner = right->left;
+  const NodePtr& outer = right->right;
+  if (inner->depth <= left->depth + 1) {
+    NodePtr joined = MakeConcat(left, inner);
+    if (joined->depth <= outer->depth + 1) {
+      return MakeConcat(std::move(joined), outer);
+    }
+    return RotateRight(MakeConcat(RotateLeft(joined), outer));
+  }
+  NodePtr joined = JoinLeft(left, inner);
+  bool balanced = joined->depth <= outer->depth + 1;
+  NodePtr result = MakeConcat(std::move(joined), outer);
+  return (balanced ? result : RotateRight(result));
+}
+
+// Appending a short piece extends the last leaf instead of adding a node per append. Replacing a
+// leaf by a leaf keeps every depth, so the spine is simply rebuilt. Returns null if the merged leaf
+// would be too long.
+Rope::NodePtr Rope::MergeIntoLastLeaf(const NodePtr& node, const Node& leaf) {
+  if (node->text) {
+    return (node->size + leaf.size <= kShortLeaf ? MakeLeaf(LeafView(*node), LeafView(leaf)) : nullptr);
+  }
+  NodePtr right = MergeIntoLastLeaf(node->right, leaf);
+  return (right ? MakeConcat(node->left, std::move(right)) : nullptr);
+}
+
+Rope::NodePtr Rope::MergeIntoFirstLeaf(const Node& leaf, const NodePtr& node) {
+  if (node->text) {
+    return (leaf.size + node->size <= kShortLeaf ? MakeLeaf(LeafView(leaf), LeafView(*node)) : nullptr);
+  }
+  NodePtr left = MergeIntoFirstLeaf(leaf, node->left);
+  return (left ? MakeConcat(std::move(left), node->right) : nullptr);
+}
+
+Rope::NodePtr Rope::Concat(const NodePtr& left, const NodePtr& right) {
+  if (!left || left->size == 0) {
+    return right;
+  }
+  if (!right || right->size == 0) {
+    return left;
+  }
+  if (right->text && right->size < kShortLeaf) {
+    if (NodePtr merged = MergeIntoLastLeaf(left, *right)) {
+      return merged;
+    }
+  }
+  if (left->text && left->size < kShortLeaf) {
+    if (NodePtr merged = MergeIntoFirstLeaf(*left, right)) {
+      return merged;
+    }
+  }
+  if (left->depth > right->depth + 1) {
+    return JoinRight(left, right);
+  }
+  if (right->depth > left->depth + 1) {
+    return JoinLeft(left, right);
+  }
+  return MakeConcat(left, right);
+}
+
+Rope::NodePtr Rope::Slice(const NodePtr& node, size_t position, size_t count) {
+  if (count == 0) {
+    return nullptr;
+  }
+  if (position == 0 && count == node->size) {
+    return node;
+  }
+  if (node->text) {
+    return MakeLeaf(node->text, node->offset + position, count);
+  }
+  size_t left_size = node->left->size;
+  if (position + count <= left_size) {
+    return Slice(node->left, position, count);
+  }
+  if (position >= left_size) {
+    return Slice(node->right, position - left_size, count);
+  }
+  return Concat(Slice(node->left, position, left_size - position),
+                Slice(node->right, 0, position + count - left_size));
+}
+
+Rope::Rope(StringView view) : Rope(String(view)) {
+}
+
+Rope::Rope(String&& text) {
+  size_t size = text.Size();
+  if (size != 0) {
+    root_ = MakeLeaf(std::make_shared<const String>(std::move(text)), 0, size);
+  }
+}
+
+size_t Rope::Size() const noexcept {
+  return (root_ ? root_->size : 0);
+}
+
+bool Rope::Empty() const noexcept {
+  return (Size() == 0);
+}
+
+size_t Rope::Depth() const noexcept {
+  return (root_ ? root_->depth : 0);
+}
+
+char Rope::operator[](size_t index) const {
+  const Node* node = root_.get();
+  while (!node->text) {
+    if (index < node->left->size) {
+      node = node->left.get();
+    } else {
+      index -= node->left->size;
+      node = node->right.get();
+    }
+  }
+  return (*node->text)[node->offset + index];
+}
+
+char Rope::At(size_t index) const {
+  if (index >= Size()) {
+    throw StringOutOfRange{};
+  }
+  return (*this)[index];
+}
+
+Rope& Rope::operator+=(const Rope& other) {
+  root_ = Concat(root_, other.root_);
+  return *this;
+}
+
+Rope Rope::Substr(size_t position, size_t count) const {
+  if (position > Size()) {
+    throw StringOutOfRange{};
+  }
+  count = std::min(count, Size() - position);
+  return Rope(count == 0 ? nullptr : Slice(root_, position, count));
+}
+
+String Rope::ToString() const {
+  String result;
+  result.Reserve(Size());
+  ForEachChunk([&result](StringView chunk) { result += chunk; });
+  return result;
+}
+
+Rope operator+(const Rope& rope1, const Rope& rope2) {
+  return Rope(Rope::Concat(rope1.root_, rope2.root_));
+}
+
+bool operator==(const Rope& rope1, const Rope& rope2) {
+  return rope1.Size() == rope2.Size() && rope1.ToString() == rope2.ToString();
+}
+
+bool operator!=(const Rope& rope1, const Rope& rope2) {
+  return !(rope1 == rope2);
+}
@@ -0,0 +1,81 @@
+#ifndef ROPE_H_
+#define ROPE_H_
+
+#include <memory>
+
+#include "cppstring.h"
+
+// Immutable text stored as an AVL-balanced tree of shared String pieces: the depths of the two
+// children of a node differ by at most one. Concatenation and slicing rebuild only the O(log n)
+// nodes along one spine and never copy the text; ToString() flattens with one allocation.
+class Rope {
+ private:
+  struct Node {
+    size_t size;
+    size_t depth;  // Height of the subtree; leaves are 0.
+    std::shared_ptr<const Node> left;
+    std::shared_ptr<const Node> right;
+    std::shared_ptr<const String> text;
+    size_t offset;
+  };
+  using NodePtr = std::shared_ptr<const Node>;
+  // Pieces shorter than this are merged by copying rather than linked.
+  static constexpr size_t kShortLeaf = 256;
+  NodePtr root_;
+
+  explicit Rope(NodePtr root) noexcept : root_(std::move(root)) {
+  }
+  static NodePtr MakeLeaf(std::shared_ptr<const String> text, size_t offset, size_t size);
+  static NodePtr MakeLeaf(StringView, StringView);
+  static NodePtr MakeConcat(NodePtr left, NodePtr right);
+  static NodePtr RotateLeft(const NodePtr& node);
+  static NodePtr RotateRight(const NodePtr& node);
+  static NodePtr JoinRight(const NodePtr& left, const NodePtr& right);
+  static NodePtr JoinLeft(const NodePtr& left, const NodePtr& right);
+  static NodePtr MergeIntoLastLeaf(const NodePtr& node, const Node& leaf);
+  static NodePtr MergeIntoFirstLeaf(const Node& leaf, const NodePtr& node);
+  static NodePtr Concat(const NodePtr& left, const NodePtr& right);
+  static NodePtr Slice(const NodePtr& node, size_t position, size_t count);
+  static StringView LeafView(const Node& node) noexcept;
+  template <class Visitor>
+  static void VisitLeaves(const Node& node, Visitor& visitor);
+
+ public:
+  Rope() noexcept = default;
+  explicit Rope(StringView);
+  explicit Rope(String&&);
+
+  size_t Size() const noexcept;
+  bool Empty() const noexcept;
+  size_t Depth() const noexcept;
+  char operator[](size_t) const;
+  char At(size_t) const;
+  Rope& operator+=(const Rope&);
+  Rope Substr(size_t position, size_t count = StringView::kNpos) const;
+  String ToString() const;
+  // Calls visitor(StringView) for each stored piece, in order.
+  template <class Visitor>
+  void ForEachChunk(Visitor visitor) const;
+  friend Rope operator+(const Rope&, const Rope&);
+};
+
+bool operator==(const Rope&, const Rope&);
+bool operator!=(const Rope&, const Rope&);
+
+template <class Visitor>
+void Rope::VisitLeaves(const Node& node, Visitor& visitor) {
+  if (node.text) {
+    visitor(LeafView(node));
+  } else {
+    VisitLeaves(*node.left, visitor);
+    VisitLeaves(*node.right, visitor);
+  }
+}
+
+template <class Visitor>
+void Rope::ForEachChunk(Visitor visitor) const {
+  if (root_) {
+    VisitLeaves(*root_, visitor);
+  }
+}
+#endif
@@ -0,0 +1,100 @@
+#include "shared_string.h"
+
+#include <new>
+
+#include "../cstring/cstring.h"
+
+char* SharedString::Chars(Rep* rep) noexcept {
+  return reinterpret_cast<char*>(rep + 1);
+}
+
+SharedString::SharedString(StringView view) : rep_(nullptr) {
+  if (!view.Empty()) {
+    rep_ = new (operator new(sizeof(Rep) + view.Size() + 1)) Rep{{1}, view.Size()};
+    Memcpy(Chars(rep_), view.Data(), view.Size());
+    Chars(rep_)[view.Size()] = '\0';
+  }
+}
+
+SharedString::SharedString(const SharedString& other) noexcept : rep_(other.rep_) {
+  if (rep_ != nullptr) {
+    rep_->references.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+SharedString::SharedString(SharedString&& other) noexcept : rep_(other.rep_) {
+  other.rep_ = nullptr;
+}
+
+SharedString& SharedString::operator=(const SharedString& other) noexcept {
+  SharedString copy = other;
+  Swap(copy);
+  return *this;
+}
+
+SharedString& SharedString::operator=(SharedString&& other) noexcept {
+  if (&other != this) {
+    Release();
+    rep_ = other.rep_;
+    other.rep_ = nullptr;
+  }
+  return *this;
+}
+
+void SharedString::Release() noexcept {
+  if (rep_ != nullptr && rep_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    rep_->~Rep();
+    operator delete(rep_);
+  }
+  rep_ = nullptr;
+}
+
+SharedString::~SharedString() {
+  Release();
+}
+
+const char* SharedString::Data() const noexcept {
+  return (rep_ == nullptr ? "" : Chars(rep_));
+}
+
+const char* SharedString::CStr() const noexcept {
+  return Data();
+}
+
+size_t SharedString::Size() const noexcept {
+  return (rep_ == nullptr ? 0 : rep_->size);
+}
+
+bool SharedString::Empty() const noexcept {
+  return (Size() == 0);
+}
+
+size_t SharedString::UseCount() const noexcept {
+  return (rep_ == nullptr ? 0 : rep_->references.load(std::memory_order_relaxed));
+}
+
+String SharedString::ToString() const {
+  return String(Data(), Size());
+}
+
+SharedString::operator StringView() const noexcept {
+  return StringView(Data(), Size());
+}
+
+void SharedString::Swap(SharedString& other) noexcept {
+  Rep* temp = rep_;
+  rep_ = other.rep_;
+  other.rep_ = temp;
+}
+
+bool operator==(const SharedString& string1, const SharedString& string2) {
+  return string1.rep_ == string2.rep_ || StringView(string1) == StringView(string2);
+}
+
+bool operator!=(const SharedString& string1, const SharedString& string2) {
+  return !(string1 == string2);
+}
+
+bool operator<(const SharedString& string1, const SharedString& string2) {
+  return StringView(string1) < StringView(string2);
+}
@@ -0,0 +1,52 @@
+#ifndef SHARED_STRING_H_
+#define SHARED_STRING_H_
+
+#include <atomic>
+#include <type_traits>
+
+#include "cppstring.h"
+
+// Immutable string with an atomic reference count: copies share one buffer and cost one atomic
+// increment instead of an allocation and a copy.
+class SharedString {
+ private:
+  struct Rep {
+    std::atomic<size_t> references;
+    size_t size;
+  };
+  Rep* rep_;
+  static char* Chars(Rep*) noexcept;
+  void Release() noexcept;
+
+ public:
+  using TriviallyRelocatable = std::true_type;
+  SharedString() noexcept : rep_(nullptr) {
+  }
+  explicit SharedString(StringView);
+  SharedString(const SharedString&) noexcept;
+  SharedString(SharedString&&) noexcept;
+  SharedString& operator=(const SharedString&) noexcept;
+  SharedString& operator=(SharedString&&) noexcept;
+  ~SharedString();
+
+  const char* Data() const noexcept;
+  const char* CStr() const noexcept;
+  size_t Size() const noexcept;
+  bool Empty() const noexcept;
+  size_t UseCount() const noexcept;
+  String ToString() const;
+  operator StringView() const noexcept;  // NOLINT
+  void Swap(SharedString&) noexcept;
+  friend bool operator==(const SharedString&, const SharedString&);
+};
+
+bool operator!=(const SharedString&, const SharedString&);
+bool operator<(const SharedString&, const SharedString&);
+
+template <>
+struct std::hash<SharedString> {
+  size_t operator()(const SharedString& string) const noexcept {
+    return StringView(string).Hash();
+  }
+};
+#endif
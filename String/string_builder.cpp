@@ -0,0 +1,73 @@
+#include "string_builder.h"
+
+#include "../cstring/cstring.h"
+
+StringBuilder::StringBuilder()
+    : arena_(kFirstChunkSize), current_(nullptr), end_(nullptr), next_chunk_size_(kFirstChunkSize), size_(0) {
+}
+
+void StringBuilder::NewChunk(size_t min_size) {
+  size_t size = std::max(min_size, next_chunk_size_);
+  current_ = static_cast<char*>(arena_.Allocate(size, 1));
+  end_ = current_ + size;
+  next_chunk_size_ = std::min(2 * next_chunk_size_, kMaxChunkSize);
+  chunks_.PushBack(StringView(current_, 0));
+}
+
+void StringBuilder::CopyToChunk(const char* data, size_t size) {
+  if (size != 0) {
+    Memcpy(current_, data, size);
+    current_ += size;
+    size_ += size;
+    StringView& last = chunks_.Back();
+    last = StringView(last.Data(), last.Size() + size);
+  }
+}
+
+// Text that does not fit fills the rest of the current chunk and continues in a new one.
+StringBuilder& StringBuilder::Append(StringView view) {
+  size_t head = std::min(view.Size(), static_cast<size_t>(end_ - current_));
+  CopyToChunk(view.Data(), head);
+  if (head < view.Size()) {
+    NewChunk(view.Size() - head);
+    CopyToChunk(view.Data() + head, view.Size() - head);
+  }
+  return *this;
+}
+
+StringBuilder& StringBuilder::Append(char symbol) {
+  return Append(StringView(&symbol, 1));
+}
+
+StringBuilder& StringBuilder::operator+=(StringView view) {
+  return Append(view);
+}
+
+StringBuilder& StringBuilder::operator+=(char symbol) {
+  return Append(symbol);
+}
+
+size_t StringBuilder::Size() const noexcept {
+  return size_;
+}
+
+bool StringBuilder::Empty() const noexcept {
+  return (size_ == 0);
+}
+
+void StringBuilder::Clear() noexcept {
+  arena_.Release();
+  chunks_.Clear();
+  current_ = end_ = nullptr;
+  next_chunk_size_ = kFirstChunkSize;
+  size_ = 0;
+}
+
+String StringBuilder::Build() const {
+  String result;
+  result.Reserve(size_);
+  for (size_t i = 0; i < chunks_.Size(); ++i) {
+    result += chunks_[i];
+  }
+  return result;
+}
@@ -0,0 +1,37 @@
+#ifndef STRING_BUILDER_H_
+#define STRING_BUILDER_H_
+
+#include "../allocator.h"
+#include "../vector.h"
+#include "cppstring.h"
+
+// Accumulates appended text in arena chunks that are never copied as they fill up; Build()
+// materializes the result with a single allocation.
+class StringBuilder {
+ private:
+  static constexpr size_t kFirstChunkSize = 256;
+  static constexpr size_t kMaxChunkSize = size_t(1) << 20;
+  ArenaResource arena_;
+  Vector<StringView> chunks_;
+  char* current_;
+  char* end_;
+  size_t next_chunk_size_;
+  size_t size_;
+  void NewChunk(size_t min_size);
+  void CopyToChunk(const char*, size_t);
+
+ public:
+  StringBuilder();
+  StringBuilder(const StringBuilder&) = delete;
+  StringBuilder& operator=(const StringBuilder&) = delete;
+
+  StringBuilder& Append(StringView);
+  StringBuilder& Append(char);
+  StringBuilder& operator+=(StringView);
+  StringBuilder& operator+=(char);
+  size_t Size() const noexcept;
+  bool Empty() const noexcept;
+  void Clear() noexcept;
+  String Build() const;
+};
+#endif
@@ -0,0 +1,107 @@
+#include "string_view.h"
+
+#include <algorithm>
+
+#include "../cstring/cstring.h"
+#include "../hash.h"
+
+StringView::StringView(const char* string) : string_(string), size_(Strlen(string)) {
+}
+
+const char& StringView::At(size_t index) const {
+  if (index >= size_) {
+    throw StringViewOutOfRange{};
+  }
+  return string_[index];
+}
+
+void StringView::RemovePrefix(size_t count) {
+  count = std::min(count, size_);
+  string_ += count;
+  size_ -= count;
+}
+
+void StringView::RemoveSuffix(size_t count) {
+  size_ -= std::min(count, size_);
+}
+
+StringView StringView::Substr(size_t position, size_t count) const {
+  if (position > size_) {
+    throw StringViewOutOfRange{};
+  }
+  return StringView(string_ + position, std::min(count, size_ - position));
+}
+
+size_t StringView::Find(char symbol, size_t position) const {
+  if (position >= size_) {
+    return kNpos;
+  }
+  const char* found = Memchr(string_ + position, symbol, size_ - position);
+  return (found == nullptr ? kNpos : found - string_);
+}
+
+size_t StringView::Find(StringView pattern, size_t position) const {
+  if (position > size_) {
+    return kNpos;
+  }
+  const char* found = Memmem(string_ + position, size_ - position, pattern.string_, pattern.size_);
+  return (found == nullptr ? kNpos : found - string_);
+}
+
+size_t StringView::RFind(char symbol) const {
+  for (size_t i = size_; i > 0; --i) {
+    if (string_[i - 1] == symbol) {
+      return i - 1;
+    }
+  }
+  return kNpos;
+}
+
+bool StringView::StartsWith(StringView prefix) const {
+  return prefix.size_ <= size_ && Memcmp(string_, prefix.string_, prefix.size_) == 0;
+}
+
+bool StringView::EndsWith(StringView suffix) const {
+  return suffix.size_ <= size_ && Memcmp(string_ + (size_ - suffix.size_), suffix.string_, suffix.size_) == 0;
+}
+
+int StringView::Compare(StringView other) const {
+  int result = Memcmp(string_, other.string_, std::min(size_, other.size_));
+  if (result != 0) {
+    return result;
+  }
+  return (size_ < other.size_ ? -1 : (size_ > other.size_ ? 1 : 0));
+}
+
+size_t StringView::Hash() const noexcept {
+  return static_cast<size_t>(HashBytes(string_, size_));
+}
+
+bool operator==(StringView view1, StringView view2) {
+  return view1.Size() == view2.Size() && Memcmp(view1.Data(), view2.Data(), view1.Size()) == 0;
+}
+
+bool operator!=(StringView view1, StringView view2) {
+  return !(view1 == view2);
+}
+
+bool operator<(StringView view1, StringView view2) {
+  return view1.Compare(view2) < 0;
+}
+
+bool operator>(StringView view1, StringView view2) {
+  return view2 < view1;
+}
+
+bool operator<=(StringView view1, StringView view2) {
+  return !(view2 < view1);
+}
+
+bool operator>=(StringView view1, StringView view2) {
+  return !(view1 < view2);
+}
+
+std::ostream& operator<<(std::ostream& os, StringView view) {
+  os.write(view.Data(), static_cast<std::streamsize>(view.Size()));
+  return os;
+}
@@ -0,0 +1,87 @@
+#ifndef STRING_VIEW_H_
+#define STRING_VIEW_H_
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+class StringViewOutOfRange : public std::out_of_range {
+ public:
+  StringViewOutOfRange() : std::out_of_range("StringViewOutOfRange") {
+  }
+};
+
+// Non-owning, not necessarily null-terminated run of chars: a pointer and a length. The viewed
+// buffer must outlive the view.
+class StringView {
+ private:
+  const char* string_;
+  size_t size_;
+
+ public:
+  static constexpr size_t kNpos = static_cast<size_t>(-1);
+
+  StringView() noexcept : string_(""), size_(0) {
+  }
+  StringView(const char*);  // NOLINT
+  StringView(const char* string, size_t size) noexcept : string_(string), size_(size) {
+  }
+
+  const char& operator[](size_t index) const {
+    return string_[index];
+  }
+  const char& At(size_t) const;
+  const char& Front() const {
+    return string_[0];
+  }
+  const char& Back() const {
+    return string_[size_ - 1];
+  }
+  const char* Data() const noexcept {
+    return string_;
+  }
+  size_t Size() const noexcept {
+    return size_;
+  }
+  size_t Length() const noexcept {
+    return size_;
+  }
+  bool Empty() const noexcept {
+    return (size_ == 0);
+  }
+
+  void RemovePrefix(size_t);
+  void RemoveSuffix(size_t);
+  StringView Substr(size_t position, size_t count = kNpos) const;
+  size_t Find(char symbol, size_t position = 0) const;
+  size_t Find(StringView pattern, size_t position = 0) const;
+  size_t RFind(char symbol) const;
+  bool StartsWith(StringView) const;
+  bool EndsWith(StringView) const;
+  int Compare(StringView) const;
+  size_t Hash() const noexcept;
+
+  const char* begin() const noexcept {  // NOLINT
+    return string_;
+  }
+  const char* end() const noexcept {  // NOLINT
+    return string_ + size_;
+  }
+};
+
+bool operator==(StringView, StringView);
+bool operator!=(StringView, StringView);
+bool operator<(StringView, StringView);
+bool operator>(StringView, StringView);
+bool operator<=(StringView, StringView);
+bool operator>=(StringView, StringView);
+std::ostream& operator<<(std::ostream&, StringView);
+
+template <>
+struct std::hash<StringView> {
+  size_t operator()(StringView view) const noexcept {
+    return view.Hash();
+  }
+};
+#endif
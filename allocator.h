@@ -0,0 +1,284 @@
+#ifndef ALLOCATOR_H_
+#define ALLOCATOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Monotonic arena: allocations bump a pointer inside the current block, Deallocate is a no-op and
+// everything is returned at once by Release() or the destructor.
+class ArenaResource {
+ private:
+  struct Block {
+    Block* next;
+    size_t size;
+  };
+  static constexpr size_t kDefaultBlockSize = 4096;
+  Block* head_;
+  char* current_;
+  char* end_;
+  size_t next_block_size_;
+  void AllocateBlock(size_t min_bytes);
+
+ public:
+  explicit ArenaResource(size_t initial_block_size = kDefaultBlockSize);
+  ArenaResource(const ArenaResource&) = delete;
+  ArenaResource& operator=(const ArenaResource&) = delete;
+  void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+  void Deallocate(void*, size_t, size_t = alignof(std::max_align_t)) noexcept {
+  }
+  void* Reallocate(void* ptr, size_t old_bytes, size_t new_bytes, size_t alignment = alignof(std::max_align_t));
+  void Release() noexcept;
+  ~ArenaResource();
+};
+
+inline ArenaResource::ArenaResource(size_t initial_block_size)
+    : head_(nullptr), current_(nullptr), end_(nullptr), next_block_size_(initial_block_size) {
+  if (next_block_size_ < sizeof(Block)) {
+    next_block_size_ = kDefaultBlockSize;
+  }
+}
+
+inline void ArenaResource::AllocateBlock(size_t min_bytes) {
+  size_t size = next_block_size_;
+  while (size < min_bytes + sizeof(Block) + alignof(std::max_align_t)) {
+    size *= 2;
+  }
+  auto block = static_cast<Block*>(operator new(size));
+  block->next = head_;
+  block->size = size;
+  head_ = block;
+  current_ = reinterpret_cast<char*>(block + 1);
+  end_ = reinterpret_cast<char*>(block) + size;
+  next_block_size_ = size * 2;
+}
+
+inline void* ArenaResource::Allocate(size_t bytes, size_t alignment) {
+  auto address = reinterpret_cast<uintptr_t>(current_);
+  auto aligned = (address + alignment - 1) & ~(alignment - 1);
+  if (current_ == nullptr || aligned + bytes > reinterpret_cast<uintptr_t>(end_)) {
+    AllocateBlock(bytes + alignment);
+    address = reinterpret_cast<uintptr_t>(current_);
+    aligned = (address + alignment - 1) & ~(alignment - 1);
+  }
+  current_ = reinterpret_cast<char*>(aligned + bytes);
+  return reinterpret_cast<void*>(aligned);
+}
+
+// The most recent allocation is grown or shrunk in place while its block has room.
+inline void* ArenaResource::Reallocate(void* ptr, size_t old_bytes, size_t new_bytes, size_t alignment) {
+  auto begin = static_cast<char*>(ptr);
+  if (begin + old_bytes == current_ && new_bytes <= static_cast<size_t>(end_ - begin)) {
+    current_ = begin + new_bytes;
+    return ptr;
+  }
+  void* result = Allocate(new_bytes, alignment);
+  std::memcpy(result, ptr, std::min(old_bytes, new_bytes));
+  return result;
+}
+
+inline void ArenaResource::Release() noexcept {
+  while (head_ != nullptr) {
+    Block* next = head_->next;
+    operator delete(head_);
+    head_ = next;
+  }
+  current_ = end_ = nullptr;
+}
+
+inline ArenaResource::~ArenaResource() {
+  Release();
+}
+
+// Size-class pool: requests up to kMaxPooledSize are rounded up to a power of two and served from
+// per-class free lists carved out of an internal arena; larger requests go to the global heap.
+class PoolResource {
+ private:
+  struct FreeNode {
+    FreeNode* next;
+  };
+  static constexpr size_t kMinClassSize = sizeof(FreeNode);
+  static constexpr size_t kClassCount = 10;
+  static constexpr size_t kMaxPooledSize = kMinClassSize << (kClassCount - 1);
+  static constexpr size_t kChunkCount = 32;
+  ArenaResource arena_;
+  FreeNode* free_lists_[kClassCount];
+  static size_t ClassIndex(size_t bytes);
+
+ public:
+  PoolResource();
+  PoolResource(const PoolResource&) = delete;
+  PoolResource& operator=(const PoolResource&) = delete;
+  void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+  void Deallocate(void* ptr, size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept;
+  void* Reallocate(void* ptr, size_t old_bytes, size_t new_bytes, size_t alignment = alignof(std::max_align_t));
+  void Release() noexcept;
+};
+
+inline PoolResource::PoolResource() : arena_(kMaxPooledSize * kChunkCount), free_lists_() {
+}
+
+inline size_t PoolResource::ClassIndex(size_t bytes) {
+  size_t index = 0;
+  size_t class_size = kMinClassSize;
+  while (class_size < bytes) {
+    class_size *= 2;
+    ++index;
+  }
+  return index;
+}
+
+inline void* PoolResource::Allocate(size_t bytes, size_t alignment) {
+  if (bytes > kMaxPooledSize || alignment > alignof(std::max_align_t)) {
+    return operator new(bytes, std::align_val_t(alignment));
+  }
+  size_t index = ClassIndex(bytes);
+  if (free_lists_[index] == nullptr) {
+    size_t class_size = kMinClassSize << index;
+    auto chunk = static_cast<char*>(arena_.Allocate(class_size * kChunkCount));
+    for (size_t i = 0; i < kChunkCount; ++i) {
+      auto node = reinterpret_cast<FreeNode*>(chunk + i * class_size);
+      node->next = free_lists_[index];
+      free_lists_[index] = node;
+    }
+  }
+  FreeNode* node = free_lists_[index];
+  free_lists_[index] = node->next;
+  return node;
+}
+
+inline void PoolResource::Deallocate(void* ptr, size_t bytes, size_t alignment) noexcept {
+  if (bytes > kMaxPooledSize || alignment > alignof(std::max_align_t)) {
+    operator delete(ptr, std::align_val_t(alignment));
+    return;
+  }
+  auto node = static_cast<FreeNode*>(ptr);
+  size_t index = ClassIndex(bytes);
+  node->next = free_lists_[index];
+  free_lists_[index] = node;
+}
+
+inline void* PoolResource::Reallocate(void* ptr, size_t old_bytes, size_t new_bytes, size_t alignment) {
+  bool is_pooled = old_bytes <= kMaxPooledSize && new_bytes <= kMaxPooledSize && alignment <= alignof(std::max_align_t);
+  if (is_pooled && ClassIndex(old_bytes) == ClassIndex(new_bytes)) {
+    return ptr;
+  }
+  void* result = Allocate(new_bytes, alignment);
+  std::memcpy(result, ptr, std::min(old_bytes, new_bytes));
+  Deallocate(ptr, old_bytes, alignment);
+  return result;
+}
+
+inline void PoolResource::Release() noexcept {
+  arena_.Release();
+  for (auto& list : free_lists_) {
+    list = nullptr;
+  }
+}
+
+// Stateful allocators usable as Vector<T, Alloc>: they only hold a pointer to the resource, which
+// must outlive every container built on top of it.
+template <class T, class Resource>
+class ResourceAllocator {
+ private:
+  Resource* resource_;
+
+ public:
+  using value_type = T;  // NOLINT
+  template <class U>
+  struct rebind {  // NOLINT
+    using other = ResourceAllocator<U, Resource>;  // NOLINT
+  };
+
+  explicit ResourceAllocator(Resource* resource) noexcept : resource_(resource) {
+  }
+
+  template <class U>
+  ResourceAllocator(const ResourceAllocator<U, Resource>& other) noexcept  // NOLINT
+      : resource_(other.GetResource()) {
+  }
+
+  T* allocate(size_t count) {  // NOLINT
+    return static_cast<T*>(resource_->Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, size_t count) noexcept {  // NOLINT
+    resource_->Deallocate(ptr, count * sizeof(T), alignof(T));
+  }
+
+  // Bitwise move of the buffer; Vector only calls it for trivially relocatable T.
+  T* reallocate(T* ptr, size_t old_count, size_t new_count) {  // NOLINT
+    return static_cast<T*>(resource_->Reallocate(ptr, old_count * sizeof(T), new_count * sizeof(T), alignof(T)));
+  }
+
+  Resource* GetResource() const noexcept {
+    return resource_;
+  }
+};
+
+template <class T, class U, class Resource>
+bool operator==(const ResourceAllocator<T, Resource>& first, const ResourceAllocator<U, Resource>& second) {
+  return first.GetResource() == second.GetResource();
+}
+
+template <class T, class U, class Resource>
+bool operator!=(const ResourceAllocator<T, Resource>& first, const ResourceAllocator<U, Resource>& second) {
+  return !(first == second);
+}
+
+// malloc-backed allocator whose reallocate maps to std::realloc, so large trivially relocatable
+// buffers can be grown without copying.
+template <class T>
+class MallocAllocator {
+  static_assert(alignof(T) <= alignof(std::max_align_t), "MallocAllocator does not support over-aligned types");
+
+ public:
+  using value_type = T;  // NOLINT
+
+  MallocAllocator() noexcept = default;
+
+  template <class U>
+  MallocAllocator(const MallocAllocator<U>&) noexcept {  // NOLINT
+  }
+
+  T* allocate(size_t count) {  // NOLINT
+    void* ptr = std::malloc(count * sizeof(T));
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(ptr);
+  }
+
+  void deallocate(T* ptr, size_t) noexcept {  // NOLINT
+    std::free(ptr);
+  }
+
+  T* reallocate(T* ptr, size_t, size_t new_count) {  // NOLINT
+    void* result = std::realloc(static_cast<void*>(ptr), new_count * sizeof(T));
+    if (result == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(result);
+  }
+};
+
+template <class T, class U>
+bool operator==(const MallocAllocator<T>&, const MallocAllocator<U>&) {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const MallocAllocator<T>&, const MallocAllocator<U>&) {
+  return false;
+}
+
+template <class T>
+using ArenaAllocator = ResourceAllocator<T, ArenaResource>;
+
+template <class T>
+using PoolAllocator = ResourceAllocator<T, PoolResource>;
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef BENCH_BENCH_H_
+#define BENCH_BENCH_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Minimal timing harness shared by the benchmark executables. Every benchmark checks its result
+// against a reference, so `<bench> --quick` (what ctest runs) is a correctness test that does one
+// iteration of each case.
+
+inline bool& BenchQuick() {
+  static bool quick = false;
+  return quick;
+}
+
+inline void BenchInit(int argc, char** argv) {
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--quick") == 0) {
+      BenchQuick() = true;
+    }
+  }
+}
+
+template <class T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void BenchCheck(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "benchmark check failed: %s\n", what);
+    std::exit(1);
+  }
+}
+
+// Runs body() `iterations` times (once with --quick) and prints the mean time per iteration.
+template <class Body>
+void Bench(const char* name, size_t iterations, Body body) {
+  if (BenchQuick()) {
+    iterations = 1;
+  }
+  body();
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    body();
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  std::printf("%-48s %14.1f ns/iter\n", name, elapsed.count() / static_cast<double>(iterations));
+}
+
+#endif
@@ -0,0 +1,289 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "../cstring/aho_corasick.h"
+#include "../cstring/cstring.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+// The byte-at-a-time loops cstring used before the word-at-a-time and SIMD versions, kept here as
+// the baseline. Loop distribution is disabled because GCC otherwise turns ByteStrlen into a strlen
+// call.
+#define BENCH_BYTE_LOOP __attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+BENCH_BYTE_LOOP size_t ByteStrlen(const char* str) {
+  size_t size = 0;
+  while (str[size] != '\0') {
+    ++size;
+  }
+  return size;
+}
+
+BENCH_BYTE_LOOP const char* ByteStrchr(const char* str, char symbol) {
+  for (; *str != '\0'; ++str) {
+    if (*str == symbol) {
+      return str;
+    }
+  }
+  return (symbol == '\0' ? str : nullptr);
+}
+
+BENCH_BYTE_LOOP const char* ByteStrrchr(const char* str, char symbol) {
+  const char* last = nullptr;
+  for (; *str != '\0'; ++str) {
+    if (*str == symbol) {
+      last = str;
+    }
+  }
+  return (symbol == '\0' ? str : last);
+}
+
+// Baseline set scans: every input byte is checked against the whole set.
+BENCH_BYTE_LOOP size_t ByteStrspn(const char* str, const char* set) {
+  size_t size = 0;
+  for (; str[size] != '\0'; ++size) {
+    bool found = false;
+    for (const char* it = set; *it != '\0' && !found; ++it) {
+      found = (*it == str[size]);
+    }
+    if (!found) {
+      break;
+    }
+  }
+  return size;
+}
+
+BENCH_BYTE_LOOP size_t ByteStrcspn(const char* str, const char* set) {
+  size_t size = 0;
+  for (; str[size] != '\0'; ++size) {
+    for (const char* it = set; *it != '\0'; ++it) {
+      if (*it == str[size]) {
+        return size;
+      }
+    }
+  }
+  return size;
+}
+
+// Calls per case scale inversely with the length so every case scans about the same number of bytes.
+size_t Calls(size_t length) {
+  size_t calls = (size_t(1) << 24) / length;
+  return (calls < 16 ? 16 : calls);
+}
+
+void ScanBenchmarks() {
+  const size_t lengths[] = {1, 16, 256, size_t(1) << 12, size_t(1) << 16, size_t(1) << 20};
+  for (size_t length : lengths) {
+    // One 'b' as the last character, so Strchr and Strrchr both scan the whole string.
+    std::string text(length, 'a');
+    text[length - 1] = 'b';
+    const char* str = text.c_str();
+    const char* last = str + length - 1;
+    char name[64];
+
+    std::snprintf(name, sizeof(name), "Strlen %zu B / cstring", length);
+    Bench(name, Calls(length), [str, length] {
+      size_t result = Strlen(str);
+      DoNotOptimize(result);
+      BenchCheck(result == length, "Strlen");
+    });
+    std::snprintf(name, sizeof(name), "Strlen %zu B / byte loop", length);
+    Bench(name, Calls(length), [str, length] {
+      size_t result = ByteStrlen(str);
+      DoNotOptimize(result);
+      BenchCheck(result == length, "byte Strlen");
+    });
+    std::snprintf(name, sizeof(name), "Strlen %zu B / libc", length);
+    Bench(name, Calls(length), [str, length] {
+      size_t result = std::strlen(str);
+      DoNotOptimize(result);
+      BenchCheck(result == length, "libc strlen");
+    });
+
+    std::snprintf(name, sizeof(name), "Strchr %zu B / cstring", length);
+    Bench(name, Calls(length), [str, last] {
+      const char* result = Strchr(str, 'b');
+      DoNotOptimize(result);
+      BenchCheck(result == last, "Strchr");
+    });
+    std::snprintf(name, sizeof(name), "Strchr %zu B / byte loop", length);
+    Bench(name, Calls(length), [str, last] {
+      const char* result = ByteStrchr(str, 'b');
+      DoNotOptimize(result);
+      BenchCheck(result == last, "byte Strchr");
+    });
+    std::snprintf(name, sizeof(name), "Strchr %zu B / libc", length);
+    Bench(name, Calls(length), [str, last] {
+      const char* result = std::strchr(str, 'b');
+      DoNotOptimize(result);
+      BenchCheck(result == last, "libc strchr");
+    });
+
+    std::snprintf(name, sizeof(name), "Strrchr %zu B / cstring", length);
+    Bench(name, Calls(length), [str, last] {
+      const char* result = Strrchr(str, 'b');
+      DoNotOptimize(result);
+      BenchCheck(result == last, "Strrchr");
+    });
+    std::snprintf(name, sizeof(name), "Strrchr %zu B / byte loop", length);
+    Bench(name, Calls(length), [str, last] {
+      const char* result = ByteStrrchr(str, 'b');
+      DoNotOptimize(result);
+      BenchCheck(result == last, "byte Strrchr");
+    });
+    std::snprintf(name, sizeof(name), "Strrchr %zu B / libc", length);
+    Bench(name, Calls(length), [str, last] {
+      const char* result = std::strrchr(str, 'b');
+      DoNotOptimize(result);
+      BenchCheck(result == last, "libc strrchr");
+    });
+  }
+}
+// Splits every line into tokens the way the log tokenizer does: skip a run of delimiters, then take
+// everything up to the next one.
+template <class Span, class ComplementSpan>
+size_t CountTokens(const Vector<std::string>& lines, const char* delimiters, Span span,
+                   ComplementSpan complement_span) {
+  size_t tokens = 0;
+  for (const auto& line : lines) {
+    const char* it = line.c_str();
+    while (true) {
+      it += span(it, delimiters);
+      if (*it == '\0') {
+        break;
+      }
+      it += complement_span(it, delimiters);
+      ++tokens;
+    }
+  }
+  return tokens;
+}
+
+Vector<std::string> MakeLogLines() {
+  Vector<std::string> lines;
+  unsigned seed = 7;
+  for (size_t i = 0; i < 4096; ++i) {
+    std::string line = "2024-05-01T12:00:00Z host=web-" + std::to_string(i % 97) + " level=info msg=\"";
+    for (size_t word = 0; word < 12; ++word) {
+      seed = seed * 1103515245 + 12345;
+      line += "request_" + std::to_string(seed % 100000) + ((seed >> 16) % 3 == 0 ? ", " : " ");
+    }
+    line += "\" latency_ms=" + std::to_string(i % 1000) + " path=/api/v1/items;id=" + std::to_string(i);
+    lines.PushBack(line);
+  }
+  return lines;
+}
+
+void TokenizerBenchmarks() {
+  Vector<std::string> lines = MakeLogLines();
+  const char* sets[] = {" =\",;:/|\t[]", " =\",;:/|\t[](){}<>!?@#$%^&*+~`'-_.", " =\",;:/|\t[](){}<>!?@#$%^&*+~`'-_.0123456789"};
+  for (const char* set : sets) {
+    size_t expected = CountTokens(lines, set, ByteStrspn, ByteStrcspn);
+    BenchCheck(expected == CountTokens(lines, set, std::strspn, std::strcspn), "libc token count");
+    char name[64];
+    size_t set_size = std::strlen(set);
+    std::snprintf(name, sizeof(name), "tokenize 4Ki lines, %zu delimiters / cstring", set_size);
+    Bench(name, 20, [&lines, set, expected] {
+      BenchCheck(CountTokens(lines, set, Strspn, Strcspn) == expected, "Strspn token count");
+    });
+    std::snprintf(name, sizeof(name), "tokenize 4Ki lines, %zu delimiters / byte loop", set_size);
+    Bench(name, 20, [&lines, set, expected] {
+      BenchCheck(CountTokens(lines, set, ByteStrspn, ByteStrcspn) == expected, "byte token count");
+    });
+    std::snprintf(name, sizeof(name), "tokenize 4Ki lines, %zu delimiters / libc", set_size);
+    Bench(name, 20, [&lines, set, expected] {
+      BenchCheck(CountTokens(lines, set, std::strspn, std::strcspn) == expected, "libc token count");
+    });
+    std::snprintf(name, sizeof(name), "Strpbrk 4Ki lines, %zu delimiters / cstring", set_size);
+    Bench(name, 20, [&lines, set] {
+      size_t found = 0;
+      for (const auto& line : lines) {
+        const char* it = Strpbrk(line.c_str(), set);
+        found += (it != nullptr && it == std::strpbrk(line.c_str(), set) ? 1 : 0);
+      }
+      BenchCheck(found == lines.Size(), "Strpbrk");
+    });
+  }
+}
+// ~500 keywords scanned over every log line: one pass per keyword with Strstr against one pass in
+// total with the compiled matcher.
+Vector<std::string> MakeKeywords() {
+  const char* const stems[] = {"error", "timeout", "refused", "panic", "overflow", "denied", "retry", "fatal",
+                               "corrupt", "leak"};
+  Vector<std::string> keywords;
+  for (size_t i = 0; keywords.Size() < 500; ++i) {
+    // Fixed-width suffixes keep any keyword from occurring inside another.
+    std::string number = std::to_string(1000 + i * 37 % 1000);
+    keywords.PushBack(std::string(stems[i % 10]) + "_" + number.substr(1));
+  }
+  return keywords;
+}
+
+size_t CountLinesWithStrstr(const Vector<std::string>& lines, const Vector<const char*>& keywords) {
+  size_t hits = 0;
+  for (const auto& line : lines) {
+    for (const char* keyword : keywords) {
+      if (Strstr(line.c_str(), keyword) != nullptr) {
+        ++hits;
+        break;
+      }
+    }
+  }
+  return hits;
+}
+
+size_t CountLinesWithMatcher(const Vector<std::string>& lines, const AhoCorasick& matcher) {
+  size_t hits = 0;
+  for (const auto& line : lines) {
+    hits += (matcher.Contains(line.data(), line.size()) ? 1 : 0);
+  }
+  return hits;
+}
+
+size_t CountMatchesWithMatcher(const Vector<std::string>& lines, const AhoCorasick& matcher) {
+  Vector<AhoCorasick::Match> matches;
+  size_t total = 0;
+  for (const auto& line : lines) {
+    matches.Clear();
+    total += matcher.FindAll(line.data(), line.size(), &matches);
+  }
+  return total;
+}
+
+void MultiPatternBenchmarks() {
+  Vector<std::string> keywords = MakeKeywords();
+  Vector<const char*> patterns;
+  for (const auto& keyword : keywords) {
+    patterns.PushBack(keyword.c_str());
+  }
+  AhoCorasick matcher(patterns.Data(), patterns.Size());
+  // Every eighth line carries one keyword.
+  Vector<std::string> lines = MakeLogLines();
+  for (size_t i = 0; i < lines.Size(); i += 8) {
+    lines[i] += " " + keywords[i % keywords.Size()];
+  }
+  size_t expected = (lines.Size() + 7) / 8;
+  Bench("500 keywords over 4Ki lines / Strstr per keyword", 3, [&lines, &patterns, expected] {
+    BenchCheck(CountLinesWithStrstr(lines, patterns) == expected, "Strstr line count");
+  });
+  Bench("500 keywords over 4Ki lines / AhoCorasick", 20, [&lines, &matcher, expected] {
+    BenchCheck(CountLinesWithMatcher(lines, matcher) == expected, "AhoCorasick line count");
+  });
+  Bench("500 keywords over 4Ki lines / AhoCorasick FindAll", 20, [&lines, &matcher, expected] {
+    BenchCheck(CountMatchesWithMatcher(lines, matcher) == expected, "AhoCorasick match count");
+  });
+  Bench("compile 500 keywords / AhoCorasick", 20, [&patterns] {
+    AhoCorasick compiled(patterns.Data(), patterns.Size());
+    BenchCheck(compiled.PatternCount() == patterns.Size(), "AhoCorasick pattern count");
+  });
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchInit(argc, argv);
+  ScanBenchmarks();
+  TokenizerBenchmarks();
+  MultiPatternBenchmarks();
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include <cstdio>
+#include <string>
+
+#include "../String/cppstring.h"
+#include "../String/interned_string.h"
+#include "../String/shared_string.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+constexpr size_t kDistinctKeys = 1000;
+constexpr size_t kRecords = 1 << 16;
+
+// Keys long enough to be heap-allocated by String, repeated across many records.
+Vector<String> MakeKeys() {
+  Vector<String> keys;
+  for (size_t i = 0; i < kDistinctKeys; ++i) {
+    String key("service.request.attribute.");
+    key.AppendInt(static_cast<int64_t>(i));
+    keys.PushBack(key);
+  }
+  return keys;
+}
+
+template <class StringType>
+Vector<StringType> MakeRecords(const Vector<StringType>& keys) {
+  Vector<StringType> records;
+  records.Reserve(kRecords);
+  for (size_t i = 0; i < kRecords; ++i) {
+    records.PushBack(keys[(i * 7) % kDistinctKeys]);
+  }
+  return records;
+}
+
+template <class StringType>
+size_t CountMatches(const Vector<StringType>& records, const StringType& probe) {
+  size_t matches = 0;
+  for (const auto& record : records) {
+    matches += (record == probe ? 1 : 0);
+  }
+  return matches;
+}
+
+// Bytes held by the records: the handles plus every heap buffer they own or share.
+void PrintFootprint(const Vector<String>& keys) {
+  size_t key_bytes = 0;
+  for (const auto& key : keys) {
+    key_bytes += key.Capacity() + 1;
+  }
+  size_t average_key = key_bytes / kDistinctKeys;
+  size_t string_bytes = kRecords * (sizeof(String) + average_key);
+  size_t shared_bytes = kRecords * sizeof(SharedString) + key_bytes + kDistinctKeys * 2 * sizeof(size_t);
+  size_t interned_bytes = kRecords * sizeof(InternedString) + key_bytes + kDistinctKeys * sizeof(String);
+  std::printf("%-48s %14zu bytes\n", "64Ki records footprint / String", string_bytes);
+  std::printf("%-48s %14zu bytes\n", "64Ki records footprint / SharedString", shared_bytes);
+  std::printf("%-48s %14zu bytes\n", "64Ki records footprint / InternedString", interned_bytes);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchInit(argc, argv);
+  Vector<String> keys = MakeKeys();
+  Vector<SharedString> shared_keys;
+  Vector<InternedString> interned_keys;
+  for (const auto& key : keys) {
+    shared_keys.PushBack(SharedString(key));
+    interned_keys.PushBack(InternedString(key));
+  }
+
+  Bench("copy 64Ki records / String", 50,
+        [&keys] { BenchCheck(MakeRecords(keys).Size() == kRecords, "String records"); });
+  Bench("copy 64Ki records / SharedString", 50,
+        [&shared_keys] { BenchCheck(MakeRecords(shared_keys).Size() == kRecords, "SharedString records"); });
+  Bench("copy 64Ki records / InternedString", 50,
+        [&interned_keys] { BenchCheck(MakeRecords(interned_keys).Size() == kRecords, "InternedString records"); });
+
+  auto records = MakeRecords(keys);
+  auto shared_records = MakeRecords(shared_keys);
+  auto interned_records = MakeRecords(interned_keys);
+  size_t expected = CountMatches(records, keys[42]);
+  BenchCheck(expected == kRecords / kDistinctKeys || expected == kRecords / kDistinctKeys + 1, "match count");
+  Bench("compare 64Ki records / String", 200,
+        [&] { BenchCheck(CountMatches(records, keys[42]) == expected, "String matches"); });
+  Bench("compare 64Ki records / SharedString", 200,
+        [&] { BenchCheck(CountMatches(shared_records, shared_keys[42]) == expected, "SharedString matches"); });
+  Bench("compare 64Ki records / InternedString", 200,
+        [&] { BenchCheck(CountMatches(interned_records, interned_keys[42]) == expected, "InternedString matches"); });
+
+  Bench("intern 64Ki existing keys", 50, [&keys, &interned_keys] {
+    for (size_t i = 0; i < kRecords; ++i) {
+      size_t index = (i * 7) % kDistinctKeys;
+      BenchCheck(InternedString(keys[index]) == interned_keys[index], "interned lookup");
+    }
+  });
+  PrintFootprint(keys);
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include "../String/cppstring.h"
+#include "../String/rope.h"
+#include "../String/string_builder.h"
+#include "bench.h"
+
+namespace {
+constexpr size_t kPieces = 1 << 14;
+constexpr size_t kDocumentPieces = 1 << 12;
+constexpr size_t kLeafAppends = 100000;
+
+// A response assembled from many short fields, the workload StringBuilder is meant for.
+const char* const kFields[] = {"{\"id\":", "12345", ",\"name\":\"", "widget", "\",\"tags\":[\"a\",\"b\"]}", "\n"};
+constexpr size_t kFieldCount = sizeof(kFields) / sizeof(kFields[0]);
+
+size_t AppendToString() {
+  String result;
+  for (size_t i = 0; i < kPieces; ++i) {
+    result += kFields[i % kFieldCount];
+  }
+  return result.Size();
+}
+
+size_t AppendToBuilder() {
+  StringBuilder builder;
+  for (size_t i = 0; i < kPieces; ++i) {
+    builder += kFields[i % kFieldCount];
+  }
+  return builder.Build().Size();
+}
+
+size_t AppendToRope() {
+  Rope rope;
+  for (size_t i = 0; i < kPieces; ++i) {
+    rope += Rope(StringView(kFields[i % kFieldCount]));
+  }
+  return rope.ToString().Size();
+}
+
+// Pieces too long to merge into the last leaf, so every append links a new leaf and rebalances.
+size_t AppendLeaves() {
+  String piece(300, 'x');
+  Rope rope;
+  for (size_t i = 0; i < kLeafAppends; ++i) {
+    rope += Rope(StringView(piece));
+  }
+  return rope.Size();
+}
+
+// A multi-megabyte document built from 1 KiB pages, then cut into slices and spliced back together.
+Rope BuildDocument() {
+  String page(1024, 'p');
+  Rope document;
+  for (size_t i = 0; i < kDocumentPieces; ++i) {
+    document += Rope(StringView(page));
+  }
+  return document;
+}
+
+size_t SpliceRope(const Rope& document) {
+  size_t size = document.Size();
+  Rope result;
+  for (size_t i = 0; i < 64; ++i) {
+    size_t position = (i * 7919 * 1024 + 17) % size;
+    result += document.Substr(position, 4096);
+  }
+  return result.Size();
+}
+
+size_t SpliceString(const String& document) {
+  size_t size = document.Size();
+  String result;
+  for (size_t i = 0; i < 64; ++i) {
+    size_t position = (i * 7919 * 1024 + 17) % size;
+    size_t count = (position + 4096 <= size ? 4096 : size - position);
+    result += StringView(document.Data() + position, count);
+  }
+  return result.Size();
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchInit(argc, argv);
+  size_t expected = AppendToString();
+  Bench("16Ki field appends / String +=", 100,
+        [expected] { BenchCheck(AppendToString() == expected, "String append size"); });
+  Bench("16Ki field appends / StringBuilder", 100,
+        [expected] { BenchCheck(AppendToBuilder() == expected, "StringBuilder size"); });
+  Bench("16Ki field appends / Rope", 100, [expected] { BenchCheck(AppendToRope() == expected, "Rope size"); });
+
+  Bench("4Ki x 1 KiB page appends / Rope", 20,
+        [] { BenchCheck(BuildDocument().Size() == kDocumentPieces * 1024, "document size"); });
+  Bench("1e5 x 300 B leaf appends / Rope", 5,
+        [] { BenchCheck(AppendLeaves() == kLeafAppends * 300, "leaf append size"); });
+  Rope document = BuildDocument();
+  String flat = document.ToString();
+  expected = SpliceString(flat);
+  Bench("64 slices of a 4 MiB document / Rope", 1000,
+        [&document, expected] { BenchCheck(SpliceRope(document) == expected, "Rope splice size"); });
+  Bench("64 slices of a 4 MiB document / String", 1000,
+        [&flat, expected] { BenchCheck(SpliceString(flat) == expected, "String splice size"); });
+  return 0;
+}
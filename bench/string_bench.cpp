@@ -0,0 +1,270 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "../String/cppstring.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+constexpr size_t kStrings = 1 << 14;
+
+const char* const kIdentifiers[] = {"id", "key", "name", "user_id", "created_at", "status", "tx", "payload"};
+constexpr size_t kIdentifierCount = sizeof(kIdentifiers) / sizeof(kIdentifiers[0]);
+
+size_t Length(const String& string) {
+  return string.Size();
+}
+
+size_t Length(const std::string& string) {
+  return string.size();
+}
+
+// Short identifiers built from const char*: inline for String, no heap allocation per string.
+template <class StringType>
+size_t ConstructShort() {
+  size_t total = 0;
+  for (size_t i = 0; i < kStrings; ++i) {
+    StringType string(kIdentifiers[i % kIdentifierCount]);
+    DoNotOptimize(string);
+    total += Length(string);
+  }
+  return total;
+}
+
+template <class StringType>
+size_t CopyAll(const Vector<StringType>& source) {
+  Vector<StringType> copy(source);
+  size_t total = 0;
+  for (const auto& string : copy) {
+    total += Length(string);
+  }
+  return total;
+}
+
+// Appends identifiers to a short prefix, e.g. "k:" + "user_id", staying within the inline capacity.
+template <class StringType>
+size_t AppendShort() {
+  size_t total = 0;
+  for (size_t i = 0; i < kStrings; ++i) {
+    StringType string("k:");
+    string += kIdentifiers[i % kIdentifierCount];
+    string += kIdentifiers[(i + 1) % kIdentifierCount];
+    DoNotOptimize(string);
+    total += Length(string);
+  }
+  return total;
+}
+
+template <class StringType>
+Vector<StringType> MakeStrings(const char* suffix) {
+  Vector<StringType> strings;
+  for (size_t i = 0; i < kStrings; ++i) {
+    StringType string(kIdentifiers[i % kIdentifierCount]);
+    string += suffix;
+    strings.PushBack(string);
+  }
+  return strings;
+}
+
+void SsoBenchmarks() {
+  size_t expected = ConstructShort<std::string>();
+  Bench("construct 16Ki short / String", 200,
+        [expected] { BenchCheck(ConstructShort<String>() == expected, "String construct"); });
+  Bench("construct 16Ki short / std::string", 200,
+        [expected] { BenchCheck(ConstructShort<std::string>() == expected, "std::string construct"); });
+
+  auto short_strings = MakeStrings<String>("");
+  auto short_std = MakeStrings<std::string>("");
+  expected = CopyAll(short_std);
+  Bench("copy 16Ki short / String", 200,
+        [&short_strings, expected] { BenchCheck(CopyAll(short_strings) == expected, "String copy"); });
+  Bench("copy 16Ki short / std::string", 200,
+        [&short_std, expected] { BenchCheck(CopyAll(short_std) == expected, "std::string copy"); });
+
+  // Same copies with a suffix that pushes every string past the inline capacity.
+  const char* suffix = "_with_a_suffix_long_enough_to_spill";
+  auto long_strings = MakeStrings<String>(suffix);
+  auto long_std = MakeStrings<std::string>(suffix);
+  expected = CopyAll(long_std);
+  Bench("copy 16Ki heap / String", 200,
+        [&long_strings, expected] { BenchCheck(CopyAll(long_strings) == expected, "String heap copy"); });
+  Bench("copy 16Ki heap / std::string", 200,
+        [&long_std, expected] { BenchCheck(CopyAll(long_std) == expected, "std::string heap copy"); });
+
+  expected = AppendShort<std::string>();
+  Bench("operator+= 16Ki short / String", 200,
+        [expected] { BenchCheck(AppendShort<String>() == expected, "String append"); });
+  Bench("operator+= 16Ki short / std::string", 200,
+        [expected] { BenchCheck(AppendShort<std::string>() == expected, "std::string append"); });
+}
+// Numeric text: 16Ki integers and doubles of mixed magnitude and sign.
+Vector<int64_t> MakeIntegers() {
+  Vector<int64_t> values;
+  uint64_t state = 1;
+  for (size_t i = 0; i < kStrings; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    int64_t value = static_cast<int64_t>(state >> (1 + i % 48));
+    values.PushBack(i % 2 == 0 ? value : -value);
+  }
+  return values;
+}
+
+Vector<double> MakeDoubles() {
+  Vector<double> values;
+  for (size_t i = 0; i < kStrings; ++i) {
+    double value = (static_cast<double>(i) + 1.0) / 7.0;
+    values.PushBack(i % 3 == 0 ? value * 1e12 : (i % 3 == 1 ? -value : value / 1e9));
+  }
+  return values;
+}
+
+template <class Value>
+Vector<String> FormatAll(const Vector<Value>& values) {
+  Vector<String> strings;
+  for (const auto& value : values) {
+    String string;
+    if constexpr (std::is_same<Value, double>::value) {
+      string.AppendDouble(value);
+    } else {
+      string.AppendInt(value);
+    }
+    strings.PushBack(string);
+  }
+  return strings;
+}
+
+template <class Value, class Parse>
+bool ParsesBack(const Vector<String>& strings, const Vector<Value>& values, Parse parse) {
+  for (size_t i = 0; i < strings.Size(); ++i) {
+    Value value{};
+    if (!parse(strings[i], &value) || value != values[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParseWithString(const String& string, int64_t* value) {
+  return string.ParseInt(value);
+}
+
+bool ParseWithString(const String& string, double* value) {
+  return string.ParseDouble(value);
+}
+
+bool ParseWithLibc(const String& string, int64_t* value) {
+  char* end = nullptr;
+  *value = std::strtoll(string.CStr(), &end, 10);
+  return *end == '\0';
+}
+
+bool ParseWithLibc(const String& string, double* value) {
+  char* end = nullptr;
+  *value = std::strtod(string.CStr(), &end);
+  return *end == '\0';
+}
+
+template <class Value>
+bool ParseWithStream(const String& string, Value* value) {
+  std::istringstream stream(string.CStr());
+  return static_cast<bool>(stream >> *value);
+}
+
+size_t FormatWithString(const Vector<int64_t>& values) {
+  size_t total = 0;
+  String string;
+  for (int64_t value : values) {
+    string.Clear();
+    total += string.AppendInt(value).Size();
+  }
+  return total;
+}
+
+size_t FormatWithString(const Vector<double>& values) {
+  size_t total = 0;
+  String string;
+  for (double value : values) {
+    string.Clear();
+    total += string.AppendDouble(value).Size();
+  }
+  return total;
+}
+
+// %.17g always round-trips but is longer than the shortest form, so lengths are compared per method.
+size_t FormatWithSnprintf(const Vector<int64_t>& values) {
+  size_t total = 0;
+  char buffer[32];
+  for (int64_t value : values) {
+    total += std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+  }
+  return total;
+}
+
+size_t FormatWithSnprintf(const Vector<double>& values) {
+  size_t total = 0;
+  char buffer[32];
+  for (double value : values) {
+    total += std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+  }
+  return total;
+}
+
+template <class Value>
+size_t FormatWithStream(const Vector<Value>& values) {
+  size_t total = 0;
+  for (const auto& value : values) {
+    std::ostringstream stream;
+    stream.precision(17);
+    stream << value;
+    total += stream.str().size();
+  }
+  return total;
+}
+
+template <class Value>
+void NumericBenchmarks(const char* type, const Vector<Value>& values) {
+  Vector<String> strings = FormatAll(values);
+  auto with_string = [](const String& string, Value* value) { return ParseWithString(string, value); };
+  auto with_libc = [](const String& string, Value* value) { return ParseWithLibc(string, value); };
+  auto with_stream = [](const String& string, Value* value) { return ParseWithStream(string, value); };
+  BenchCheck(ParsesBack(strings, values, with_string), "String round trip");
+  std::string name(type);
+  Bench(("parse 16Ki " + name + " / String").c_str(), 100, [&strings, &values, with_string] {
+    BenchCheck(ParsesBack(strings, values, with_string), "String parse");
+  });
+  Bench(("parse 16Ki " + name + " / strto*").c_str(), 100, [&strings, &values, with_libc] {
+    BenchCheck(ParsesBack(strings, values, with_libc), "strto* parse");
+  });
+  Bench(("parse 16Ki " + name + " / std::istringstream").c_str(), 20, [&strings, &values, with_stream] {
+    BenchCheck(ParsesBack(strings, values, with_stream), "std::istringstream parse");
+  });
+
+  size_t expected = 0;
+  for (const auto& string : strings) {
+    expected += string.Size();
+  }
+  Bench(("format 16Ki " + name + " / String").c_str(), 100, [&values, expected] {
+    BenchCheck(FormatWithString(values) == expected, "String format");
+  });
+  expected = FormatWithSnprintf(values);
+  Bench(("format 16Ki " + name + " / snprintf").c_str(), 100, [&values, expected] {
+    BenchCheck(FormatWithSnprintf(values) == expected, "snprintf format");
+  });
+  expected = FormatWithStream(values);
+  Bench(("format 16Ki " + name + " / std::ostringstream").c_str(), 20, [&values, expected] {
+    BenchCheck(FormatWithStream(values) == expected, "std::ostringstream format");
+  });
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchInit(argc, argv);
+  SsoBenchmarks();
+  NumericBenchmarks("int64", MakeIntegers());
+  NumericBenchmarks("double", MakeDoubles());
+  return 0;
+}
@@ -0,0 +1,155 @@
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "../String/cppstring.h"
+#include "../allocator.h"
+#include "../small_vector.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+size_t heap_allocations = 0;
+}  // namespace
+
+// Counts every heap allocation in this executable, so benchmarks can report allocations next to
+// their timings.
+void* operator new(size_t size) {
+  ++heap_allocations;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+constexpr size_t kElements = 1 << 16;
+constexpr size_t kSmallVectors = 1 << 12;
+
+// Elements for the allocator benchmarks: a trivial int, and a String that owns a heap buffer, is
+// non-trivial to copy and destroy, but is trivially relocatable.
+template <class T>
+T MakeElement(size_t i);
+
+template <>
+int MakeElement<int>(size_t i) {
+  return static_cast<int>(i);
+}
+
+template <>
+String MakeElement<String>(size_t i) {
+  return String(32 + i % 16, 'a' + static_cast<char>(i % 26));
+}
+
+template <class Alloc>
+size_t PushBackElements(const Alloc& alloc) {
+  using T = typename Alloc::value_type;
+  Vector<T, Alloc> vector(alloc);
+  for (size_t i = 0; i < kElements; ++i) {
+    vector.PushBack(MakeElement<T>(i));
+  }
+  DoNotOptimize(vector.Data());
+  return vector.Size();
+}
+
+// Many short-lived small vectors: the case a pool or an arena is meant for.
+template <class Alloc>
+size_t ChurnSmallVectors(const Alloc& alloc) {
+  using T = typename Alloc::value_type;
+  size_t total = 0;
+  for (size_t i = 0; i < kSmallVectors; ++i) {
+    Vector<T, Alloc> vector(alloc);
+    for (size_t j = 0; j < 12; ++j) {
+      vector.PushBack(MakeElement<T>(j));
+    }
+    total += vector.Size();
+  }
+  return total;
+}
+
+template <class T>
+void AllocatorBenchmarks(const char* type) {
+  auto push_back = [type](const char* allocator) {
+    return std::string("PushBack 64Ki ") + type + "s / " + allocator;
+  };
+  auto churn = [type](const char* allocator) {
+    return std::string("4Ki small ") + type + " vectors / " + allocator;
+  };
+  Bench(push_back("std::allocator").c_str(), 100,
+        [] { BenchCheck(PushBackElements(std::allocator<T>()) == kElements, "std::allocator size"); });
+  Bench(push_back("MallocAllocator").c_str(), 100,
+        [] { BenchCheck(PushBackElements(MallocAllocator<T>()) == kElements, "MallocAllocator size"); });
+  Bench(push_back("ArenaAllocator").c_str(), 100, [] {
+    ArenaResource arena;
+    BenchCheck(PushBackElements(ArenaAllocator<T>(&arena)) == kElements, "ArenaAllocator size");
+  });
+  Bench(churn("std::allocator").c_str(), 100,
+        [] { BenchCheck(ChurnSmallVectors(std::allocator<T>()) == 12 * kSmallVectors, "std::allocator churn"); });
+  Bench(churn("PoolAllocator").c_str(), 100, [] {
+    PoolResource pool;
+    BenchCheck(ChurnSmallVectors(PoolAllocator<T>(&pool)) == 12 * kSmallVectors, "PoolAllocator churn");
+  });
+  Bench(churn("ArenaAllocator").c_str(), 100, [] {
+    ArenaResource arena;
+    BenchCheck(ChurnSmallVectors(ArenaAllocator<T>(&arena)) == 12 * kSmallVectors, "ArenaAllocator churn");
+  });
+}
+
+// Vectors of up to eight elements built and dropped in a loop; SmallVector<int, 8> never allocates.
+template <class VectorType>
+size_t BuildShortVectors() {
+  size_t total = 0;
+  for (size_t i = 0; i < kSmallVectors; ++i) {
+    VectorType vector;
+    for (size_t j = 0; j < 1 + i % 8; ++j) {
+      vector.PushBack(static_cast<int>(j));
+    }
+    DoNotOptimize(vector.Data());
+    total += vector.Size();
+  }
+  return total;
+}
+
+// Heap allocations made by one call of body().
+template <class Body>
+size_t CountAllocations(Body body) {
+  size_t before = heap_allocations;
+  body();
+  return heap_allocations - before;
+}
+
+void SmallVectorBenchmarks() {
+  size_t expected = BuildShortVectors<Vector<int>>();
+  auto vectors = [expected] { BenchCheck(BuildShortVectors<Vector<int>>() == expected, "Vector sizes"); };
+  auto small_vectors = [expected] {
+    BenchCheck(BuildShortVectors<SmallVector<int, 8>>() == expected, "SmallVector sizes");
+  };
+  size_t vector_allocations = CountAllocations(vectors);
+  size_t small_vector_allocations = CountAllocations(small_vectors);
+  BenchCheck(vector_allocations >= kSmallVectors, "Vector allocates every vector");
+  BenchCheck(small_vector_allocations == 0, "SmallVector stays inline");
+
+  Bench("4Ki vectors of 1-8 ints / Vector", 100, vectors);
+  std::printf("%-48s %14zu allocs/iter\n", "4Ki vectors of 1-8 ints / Vector", vector_allocations);
+  Bench("4Ki vectors of 1-8 ints / SmallVector<int, 8>", 100, small_vectors);
+  std::printf("%-48s %14zu allocs/iter\n", "4Ki vectors of 1-8 ints / SmallVector<int, 8>",
+              small_vector_allocations);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchInit(argc, argv);
+  AllocatorBenchmarks<int>("int");
+  AllocatorBenchmarks<String>("String");
+  SmallVectorBenchmarks();
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "../vector.h"
+#include "../vector_parallel.h"
+#include "bench.h"
+
+namespace {
+constexpr size_t kStrings = size_t(1) << 20;
+
+// Copies of a string too long for SSO, so every element allocates.
+size_t FillStrings(const ExecutionPolicy& policy, const std::string& value) {
+  Vector<std::string> vector;
+  ParallelResize(vector, policy, kStrings, value);
+  BenchCheck(vector.Back() == value && vector.Front() == value, "filled value");
+  return vector.Size();
+}
+
+size_t CopyStrings(const ExecutionPolicy& policy, const Vector<std::string>& source) {
+  Vector<std::string> vector;
+  ParallelAppend(vector, policy, source.begin(), source.end());
+  BenchCheck(vector == source, "copied range");
+  return vector.Size();
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchInit(argc, argv);
+  std::string value(48, 'x');
+  Bench("ParallelResize 1Mi strings / kSequential", 5,
+        [&value] { BenchCheck(FillStrings(kSequential, value) == kStrings, "sequential size"); });
+  Bench("ParallelResize 1Mi strings / kParallel", 5,
+        [&value] { BenchCheck(FillStrings(kParallel, value) == kStrings, "parallel size"); });
+  Vector<std::string> source;
+  for (size_t i = 0; i < kStrings; ++i) {
+    source.PushBack(std::to_string(i) + value);
+  }
+  Bench("ParallelAppend 1Mi strings / kSequential", 5,
+        [&source] { BenchCheck(CopyStrings(kSequential, source) == kStrings, "sequential copy"); });
+  Bench("ParallelAppend 1Mi strings / kParallel", 5,
+        [&source] { BenchCheck(CopyStrings(kParallel, source) == kStrings, "parallel copy"); });
+
+  // Scaling sweep: 1, 2, 4, ... threads up to the hardware thread count (at least 4), each on a pool
+  // of exactly that size.
+  size_t max_threads = std::max<size_t>(4, std::thread::hardware_concurrency());
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    ParallelPool pool(threads);
+    ExecutionPolicy policy{threads, &pool};
+    std::string suffix = " / " + std::to_string(threads) + " threads";
+    Bench(("ParallelResize 1Mi strings" + suffix).c_str(), 5,
+          [&policy, &value] { BenchCheck(FillStrings(policy, value) == kStrings, "sweep size"); });
+    Bench(("ParallelAppend 1Mi strings" + suffix).c_str(), 5,
+          [&policy, &source] { BenchCheck(CopyStrings(policy, source) == kStrings, "sweep copy"); });
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+#ifndef COW_VECTOR_H_
+#define COW_VECTOR_H_
+
+#include <atomic>
+#include <memory>
+
+#include "vector_view.h"
+
+// Copy-on-write Vector: copies share one buffer and are O(1); the first mutation through a shared
+// handle copies the buffer. std::shared_ptr is used instead of SharedPtr because snapshots are
+// handed to other threads and the reference count has to be atomic. Writes go through the mutators or
+// Update(); there is deliberately no accessor that returns a lasting mutable reference, since a
+// reference kept across a copy of the handle would write into the copy's snapshot.
+template <typename T, class Alloc = std::allocator<T>, class Growth = GeometricGrowth<>>
+class CowVector {
+ private:
+  using VectorType = Vector<T, Alloc, Growth>;
+  std::shared_ptr<VectorType> vector_;
+  Alloc alloc_;
+  VectorType& Detach();
+
+ public:
+  using ConstIterator = typename VectorType::ConstIterator;
+  using ValueType = T;
+  using SizeType = size_t;
+
+  CowVector() noexcept(noexcept(Alloc())) : alloc_() {
+  }
+  explicit CowVector(const Alloc& alloc) noexcept : alloc_(alloc) {
+  }
+  explicit CowVector(VectorType&& vector)
+      : vector_(std::make_shared<VectorType>(std::move(vector))), alloc_(vector_->GetAllocator()) {
+  }
+  CowVector(std::initializer_list<T> list, const Alloc& alloc = Alloc())  // NOLINT
+      : vector_(std::make_shared<VectorType>(list, alloc)), alloc_(alloc) {
+  }
+
+  size_t Size() const noexcept;
+  bool Empty() const noexcept;
+  const T& operator[](size_t) const;
+  const T& At(size_t) const;
+  const T& Front() const noexcept;
+  const T& Back() const noexcept;
+  const T* Data() const noexcept;
+  VectorView<const T> View() const noexcept;
+  bool IsShared() const noexcept;
+  Alloc GetAllocator() const;
+  template <class Function>
+  decltype(auto) Update(Function&&);
+  void PushBack(const T&);
+  void PushBack(T&&);
+  template <typename... Args>
+  void EmplaceBack(Args&&... args);
+  void PopBack();
+  void Resize(size_t);
+  void Clear();
+
+  ConstIterator begin() const {  // NOLINT
+    return ConstIterator(Data());
+  }
+  ConstIterator end() const {  // NOLINT
+    return ConstIterator(Data() + Size());
+  }
+};
+
+template <typename T, class Alloc, class Growth>
+size_t CowVector<T, Alloc, Growth>::Size() const noexcept {
+  return (vector_ ? vector_->Size() : 0);
+}
+
+template <typename T, class Alloc, class Growth>
+bool CowVector<T, Alloc, Growth>::Empty() const noexcept {
+  return Size() == 0;
+}
+
+template <typename T, class Alloc, class Growth>
+const T& CowVector<T, Alloc, Growth>::operator[](size_t index) const {
+  return Data()[index];
+}
+
+template <typename T, class Alloc, class Growth>
+const T& CowVector<T, Alloc, Growth>::At(size_t index) const {
+  if (index >= Size()) {
+    throw VectorOutOfRange{};
+  }
+  return Data()[index];
+}
+
+template <typename T, class Alloc, class Growth>
+const T& CowVector<T, Alloc, Growth>::Front() const noexcept {
+  return Data()[0];
+}
+
+template <typename T, class Alloc, class Growth>
+const T& CowVector<T, Alloc, Growth>::Back() const noexcept {
+  return Data()[Size() - 1];
+}
+
+template <typename T, class Alloc, class Growth>
+const T* CowVector<T, Alloc, Growth>::Data() const noexcept {
+  return (vector_ ? vector_->Data() : nullptr);
+}
+
+template <typename T, class Alloc, class Growth>
+VectorView<const T> CowVector<T, Alloc, Growth>::View() const noexcept {
+  return VectorView<const T>(Data(), Size());
+}
+
+template <typename T, class Alloc, class Growth>
+bool CowVector<T, Alloc, Growth>::IsShared() const noexcept {
+  return vector_ && vector_.use_count() > 1;
+}
+
+template <typename T, class Alloc, class Growth>
+Alloc CowVector<T, Alloc, Growth>::GetAllocator() const {
+  return alloc_;
+}
+
+// Returns the buffer for writing, copying it first if another handle still refers to it. The reference
+// must not outlive the current mutation.
+template <typename T, class Alloc, class Growth>
+typename CowVector<T, Alloc, Growth>::VectorType& CowVector<T, Alloc, Growth>::Detach() {
+  if (!vector_) {
+    vector_ = std::make_shared<VectorType>(alloc_);
+  } else if (vector_.use_count() != 1) {
+    vector_ = std::make_shared<VectorType>(*vector_, alloc_);
+  } else {
+    // Pairs with the release done by the last reader that dropped its snapshot.
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *vector_;
+}
+
+// Calls function(VectorType&) on an unshared buffer, for edits the mutators below don't cover. The
+// reference is only valid during the call: copying this CowVector inside function, or keeping the
+// reference afterwards, would let later writes reach another handle's snapshot.
+template <typename T, class Alloc, class Growth>
+template <class Function>
+decltype(auto) CowVector<T, Alloc, Growth>::Update(Function&& function) {
+  return std::forward<Function>(function)(Detach());
+}
+
+template <typename T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::PushBack(const T& value) {
+  Detach().PushBack(value);
+}
+
+template <typename T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::PushBack(T&& value) {
+  Detach().PushBack(std::move(value));
+}
+
+template <typename T, class Alloc, class Growth>
+template <typename... Args>
+void CowVector<T, Alloc, Growth>::EmplaceBack(Args&&... args) {
+  Detach().EmplaceBack(std::forward<Args>(args)...);
+}
+
+template <typename T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::PopBack() {
+  Detach().PopBack();
+}
+
+template <typename T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::Resize(size_t new_size) {
+  Detach().Resize(new_size);
+}
+
+template <typename T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::Clear() {
+  if (IsShared()) {
+    vector_.reset();
+  } else if (vector_) {
+    vector_->Clear();
+  }
+}
+
+#endif
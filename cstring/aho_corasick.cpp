@@ -0,0 +1,105 @@
+#include "aho_corasick.h"
+
+namespace {
+constexpr uint32_t kNoState = static_cast<uint32_t>(-1);
+}  // namespace
+
+AhoCorasick::AhoCorasick(const char* const* patterns, size_t count) : classes_(256), class_count_(1) {
+  Build(patterns, count);
+}
+
+AhoCorasick::AhoCorasick(std::initializer_list<const char*> patterns) : classes_(256), class_count_(1) {
+  Build(patterns.begin(), patterns.size());
+}
+
+// Bytes that occur in no pattern share class 0, so the table has one column per distinct pattern
+// byte plus one.
+void AhoCorasick::Build(const char* const* patterns, size_t count) {
+  for (size_t p = 0; p < count; ++p) {
+    lengths_.PushBack(Strlen(patterns[p]));
+    for (size_t i = 0; i < lengths_[p]; ++i) {
+      auto byte = static_cast<unsigned char>(patterns[p][i]);
+      if (classes_[byte] == 0) {
+        classes_[byte] = static_cast<uint16_t>(class_count_++);
+      }
+    }
+  }
+  // The trie: transitions_ rows are appended as states are created.
+  Vector<Vector<uint32_t>> own_outputs(1);
+  transitions_.Resize(class_count_, kNoState);
+  for (size_t p = 0; p < count; ++p) {
+    if (lengths_[p] == 0) {
+      continue;
+    }
+    uint32_t state = 0;
+    for (size_t i = 0; i < lengths_[p]; ++i) {
+      size_t cell = state * class_count_ + classes_[static_cast<unsigned char>(patterns[p][i])];
+      if (transitions_[cell] == kNoState) {
+        transitions_[cell] = static_cast<uint32_t>(own_outputs.Size());
+        own_outputs.EmplaceBack();
+        transitions_.Resize(transitions_.Size() + class_count_, kNoState);
+      }
+      state = transitions_[cell];
+    }
+    own_outputs[state].PushBack(static_cast<uint32_t>(p));
+  }
+  // Breadth-first pass: a state's failure state is shallower and already complete, so missing
+  // transitions are copied from it and its output list is appended after the state's own.
+  size_t state_count = own_outputs.Size();
+  Vector<uint32_t> failure(state_count, 0);
+  Vector<uint32_t> queue;
+  queue.PushBack(0);
+  output_begin_.Resize(state_count);
+  output_end_.Resize(state_count);
+  for (size_t head = 0; head < queue.Size(); ++head) {
+    uint32_t state = queue[head];
+    uint32_t fail = failure[state];
+    output_begin_[state] = static_cast<uint32_t>(outputs_.Size());
+    for (size_t k = 0; k < own_outputs[state].Size(); ++k) {
+      outputs_.PushBack(own_outputs[state][k]);
+    }
+    if (state != 0) {
+      for (uint32_t k = output_begin_[fail]; k < output_end_[fail]; ++k) {
+        outputs_.PushBack(outputs_[k]);
+      }
+    }
+    output_end_[state] = static_cast<uint32_t>(outputs_.Size());
+    for (size_t c = 0; c < class_count_; ++c) {
+      uint32_t& next = transitions_[state * class_count_ + c];
+      if (next == kNoState) {
+        next = (state == 0 ? 0 : transitions_[fail * class_count_ + c]);
+      } else {
+        failure[next] = (state == 0 ? 0 : transitions_[fail * class_count_ + c]);
+        queue.PushBack(next);
+      }
+    }
+  }
+}
+
+size_t AhoCorasick::PatternCount() const noexcept {
+  return lengths_.Size();
+}
+
+size_t AhoCorasick::StateCount() const noexcept {
+  return output_begin_.Size();
+}
+
+size_t AhoCorasick::FindAll(const char* text, size_t size, Vector<Match>* matches) const {
+  size_t found = 0;
+  Scan(text, size, [matches, &found](size_t pattern, size_t position) {
+    matches->PushBack(Match{pattern, position});
+    ++found;
+  });
+  return found;
+}
+
+bool AhoCorasick::Contains(const char* text, size_t size) const {
+  uint32_t state = 0;
+  for (size_t i = 0; i < size; ++i) {
+    state = transitions_[state * class_count_ + classes_[static_cast<unsigned char>(text[i])]];
+    if (output_begin_[state] != output_end_[state]) {
+      return true;
+    }
+  }
+  return false;
+}
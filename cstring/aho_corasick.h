@@ -0,0 +1,53 @@
+#ifndef AHO_CORASICK_H_
+#define AHO_CORASICK_H_
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "../vector.h"
+#include "cstring.h"
+
+// Multi-pattern matcher: the patterns are compiled into a dense DFA over byte classes, and a scan
+// reports every occurrence of every pattern in one pass over the text. Empty patterns never match.
+class AhoCorasick {
+ private:
+  Vector<uint16_t> classes_;
+  size_t class_count_;
+  Vector<uint32_t> transitions_;
+  Vector<uint32_t> output_begin_;
+  Vector<uint32_t> output_end_;
+  Vector<uint32_t> outputs_;
+  Vector<size_t> lengths_;
+  void Build(const char* const* patterns, size_t count);
+
+ public:
+  struct Match {
+    size_t pattern;
+    size_t position;
+  };
+
+  AhoCorasick(const char* const* patterns, size_t count);
+  AhoCorasick(std::initializer_list<const char*> patterns);
+
+  size_t PatternCount() const noexcept;
+  size_t StateCount() const noexcept;
+  // Calls on_match(pattern, position) for each occurrence, ordered by where it ends; position is
+  // the offset of its first byte.
+  template <class Callback>
+  void Scan(const char* text, size_t size, Callback on_match) const;
+  size_t FindAll(const char* text, size_t size, Vector<Match>* matches) const;
+  bool Contains(const char* text, size_t size) const;
+};
+
+template <class Callback>
+void AhoCorasick::Scan(const char* text, size_t size, Callback on_match) const {
+  uint32_t state = 0;
+  for (size_t i = 0; i < size; ++i) {
+    state = transitions_[state * class_count_ + classes_[static_cast<unsigned char>(text[i])]];
+    for (uint32_t k = output_begin_[state]; k < output_end_[state]; ++k) {
+      size_t pattern = outputs_[k];
+      on_match(pattern, i + 1 - lengths_[pattern]);
+    }
+  }
+}
+#endif
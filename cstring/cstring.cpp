@@ -1,11 +1,622 @@
 #include "cstring.h"
 
-size_t Strlen(const char* str) {
-  size_t len = 0;
-  while (*(str + len) != '\0') {
-    ++len;
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define CSTRING_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// The word-wide and vector scans read whole aligned blocks, which may extend past the terminator
+// but never into the next page. That is invisible to the hardware but not to AddressSanitizer.
+#if defined(__clang__) || defined(__GNUC__)
+#define CSTRING_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define CSTRING_NO_SANITIZE_ADDRESS
+#endif
+
+namespace {
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighs = 0x8080808080808080ULL;
+
+inline bool HasZeroByte(uint64_t word) {
+  return ((word - kOnes) & ~word & kHighs) != 0;
+}
+
+inline bool IsWordAligned(const char* ptr) {
+  return reinterpret_cast<uintptr_t>(ptr) % sizeof(uint64_t) == 0;
+}
+
+inline uint64_t LoadWord(const char* ptr) {
+  uint64_t word;
+  std::memcpy(&word, ptr, sizeof(word));
+  return word;
+}
+
+// Needles up to this length are found by the first-and-last-byte prefilter; its verification
+// cost per candidate is bounded by the needle length, so longer needles use Two-Way.
+constexpr size_t kShortNeedle = 32;
+
+// Both prefilter search variants take a needle of at least two bytes.
+const char* PrefilterSearchScalar(const char* haystack, size_t size, const char* needle, size_t needle_size) {
+  if (size < needle_size) {
+    return nullptr;
+  }
+  char first = needle[0];
+  char last = needle[needle_size - 1];
+  for (size_t i = 0; i <= size - needle_size; ++i) {
+    if (haystack[i] == first && haystack[i + needle_size - 1] == last &&
+        Memcmp(haystack + i + 1, needle + 1, needle_size - 2) == 0) {
+      return haystack + i;
+    }
+  }
+  return nullptr;
+}
+
+// Membership table for the set arguments of Strspn, Strcspn and Strpbrk. A byte per entry rather
+// than a bit: filling it is a plain store per member, while OR-ing bits into the same word chains
+// every member of a typical delimiter set through one store-to-load forward.
+struct ByteSet {
+  unsigned char members[256];
+  bool ascii;
+
+  ByteSet(const char* set, bool with_terminator) {
+    std::memset(members, 0, sizeof(members));
+    members[0] = with_terminator;
+    unsigned high = 0;
+    for (; *set != '\0'; ++set) {
+      auto byte = static_cast<unsigned char>(*set);
+      members[byte] = 1;
+      high |= byte;
+    }
+    ascii = (high < 0x80);
+  }
+
+  bool Contains(char symbol) const {
+    return members[static_cast<unsigned char>(symbol)] != 0;
+  }
+};
+
+// Returned by the short-set span for sets it does not handle.
+constexpr size_t kLongSet = ~size_t(0);
+
+// Bytes checked one at a time before a vector classifier is set up, so short spans stay cheap.
+constexpr size_t kScalarSpanPrefix = 16;
+
+#ifndef CSTRING_X86_SIMD
+CSTRING_NO_SANITIZE_ADDRESS size_t StrlenSwar(const char* str) {
+  const char* current = str;
+  while (!IsWordAligned(current)) {
+    if (*current == '\0') {
+      return current - str;
+    }
+    ++current;
+  }
+  while (!HasZeroByte(LoadWord(current))) {
+    current += sizeof(uint64_t);
+  }
+  while (*current != '\0') {
+    ++current;
+  }
+  return current - str;
+}
+
+CSTRING_NO_SANITIZE_ADDRESS const char* StrchrSwar(const char* str, char symbol) {
+  uint64_t pattern = kOnes * static_cast<unsigned char>(symbol);
+  while (!IsWordAligned(str) && *str != '\0' && *str != symbol) {
+    ++str;
+  }
+  if (IsWordAligned(str)) {
+    uint64_t word = LoadWord(str);
+    while (!HasZeroByte(word) && !HasZeroByte(word ^ pattern)) {
+      str += sizeof(uint64_t);
+      word = LoadWord(str);
+    }
+  }
+  while (*str != '\0' && *str != symbol) {
+    ++str;
+  }
+  return (*str == symbol ? str : nullptr);
+}
+
+CSTRING_NO_SANITIZE_ADDRESS const char* StrrchrSwar(const char* str, char symbol) {
+  if (symbol == '\0') {
+    return str + StrlenSwar(str);
+  }
+  uint64_t pattern = kOnes * static_cast<unsigned char>(symbol);
+  const char* last = nullptr;
+  while (!IsWordAligned(str) && *str != '\0') {
+    last = (*str == symbol ? str : last);
+    ++str;
+  }
+  if (*str != '\0') {
+    for (uint64_t word = LoadWord(str); !HasZeroByte(word); word = LoadWord(str)) {
+      if (HasZeroByte(word ^ pattern)) {
+        for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+          last = (str[i] == symbol ? str + i : last);
+        }
+      }
+      str += sizeof(uint64_t);
+    }
+  }
+  for (; *str != '\0'; ++str) {
+    last = (*str == symbol ? str : last);
+  }
+  return last;
+}
+
+#else
+// Vector scans start at the aligned block containing str and mask off the bytes before it.
+inline uint32_t Lowest(uint32_t mask) {
+  return static_cast<uint32_t>(__builtin_ctz(mask));
+}
+
+inline uint32_t Highest(uint32_t mask) {
+  return 31 - static_cast<uint32_t>(__builtin_clz(mask));
+}
+
+// Bits strictly below the lowest set bit of a nonzero mask.
+inline uint32_t BelowLowest(uint32_t mask) {
+  return (mask & (0u - mask)) - 1;
+}
+
+CSTRING_NO_SANITIZE_ADDRESS size_t StrlenSse2(const char* str) {
+  constexpr size_t kWidth = sizeof(__m128i);
+  const __m128i zero = _mm_setzero_si128();
+  size_t offset = reinterpret_cast<uintptr_t>(str) % kWidth;
+  const char* block = str - offset;
+  auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                  _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero))) &
+              (~0u << offset);
+  while (mask == 0) {
+    block += kWidth;
+    mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero));
+  }
+  return block + Lowest(mask) - str;
+}
+
+CSTRING_NO_SANITIZE_ADDRESS const char* StrchrSse2(const char* str, char symbol) {
+  constexpr size_t kWidth = sizeof(__m128i);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i pattern = _mm_set1_epi8(symbol);
+  size_t offset = reinterpret_cast<uintptr_t>(str) % kWidth;
+  const char* block = str - offset;
+  __m128i data = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+  auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                  _mm_or_si128(_mm_cmpeq_epi8(data, zero), _mm_cmpeq_epi8(data, pattern)))) &
+              (~0u << offset);
+  while (mask == 0) {
+    block += kWidth;
+    data = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+    mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, zero), _mm_cmpeq_epi8(data, pattern)));
+  }
+  const char* found = block + Lowest(mask);
+  return (*found == symbol ? found : nullptr);
+}
+
+CSTRING_NO_SANITIZE_ADDRESS const char* StrrchrSse2(const char* str, char symbol) {
+  if (symbol == '\0') {
+    return str + StrlenSse2(str);
   }
-  return len;
+  constexpr size_t kWidth = sizeof(__m128i);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i pattern = _mm_set1_epi8(symbol);
+  size_t offset = reinterpret_cast<uintptr_t>(str) % kWidth;
+  const char* block = str - offset;
+  const char* last = nullptr;
+  uint32_t first_bits = ~0u << offset;
+  for (;; block += kWidth, first_bits = ~0u) {
+    __m128i data = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+    auto zeros = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, zero))) & first_bits;
+    auto matches = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, pattern))) & first_bits;
+    if (zeros != 0) {
+      matches &= BelowLowest(zeros);
+    }
+    if (matches != 0) {
+      last = block + Highest(matches);
+    }
+    if (zeros != 0) {
+      return last;
+    }
+  }
+}
+
+// The AVX2 scans check single blocks up to a 4 * kAvx2Width boundary and then four blocks per step.
+// An aligned 128-byte chunk never crosses a page, and the step only looks for whether the chunk holds
+// anything interesting, so the loop carries one branch per 128 bytes.
+constexpr size_t kAvx2Width = 32;
+
+__attribute__((target("avx2"))) CSTRING_NO_SANITIZE_ADDRESS inline __m256i LoadAvx2(const char* block) {
+  return _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+}
+
+__attribute__((target("avx2"))) inline uint32_t ZeroMaskAvx2(__m256i data) {
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, _mm256_setzero_si256())));
+}
+
+// Zero exactly in the bytes equal to '\0' or to symbol.
+__attribute__((target("avx2"))) inline __m256i ZeroOrMatchAvx2(__m256i data, __m256i pattern) {
+  return _mm256_min_epu8(_mm256_xor_si256(data, pattern), data);
+}
+
+__attribute__((target("avx2"))) inline bool ChunkHasZeroAvx2(const char* chunk) {
+  __m256i low = _mm256_min_epu8(LoadAvx2(chunk), LoadAvx2(chunk + kAvx2Width));
+  __m256i high = _mm256_min_epu8(LoadAvx2(chunk + 2 * kAvx2Width), LoadAvx2(chunk + 3 * kAvx2Width));
+  return ZeroMaskAvx2(_mm256_min_epu8(low, high)) != 0;
+}
+
+__attribute__((target("avx2"))) inline bool ChunkHasZeroOrMatchAvx2(const char* chunk, __m256i pattern) {
+  __m256i low = _mm256_min_epu8(ZeroOrMatchAvx2(LoadAvx2(chunk), pattern),
+                                ZeroOrMatchAvx2(LoadAvx2(chunk + kAvx2Width), pattern));
+  __m256i high = _mm256_min_epu8(ZeroOrMatchAvx2(LoadAvx2(chunk + 2 * kAvx2Width), pattern),
+                                 ZeroOrMatchAvx2(LoadAvx2(chunk + 3 * kAvx2Width), pattern));
+  return ZeroMaskAvx2(_mm256_min_epu8(low, high)) != 0;
+}
+
+inline bool IsChunkStart(const char* block) {
+  return reinterpret_cast<uintptr_t>(block) % (4 * kAvx2Width) == 0;
+}
+
+__attribute__((target("avx2"))) CSTRING_NO_SANITIZE_ADDRESS size_t StrlenAvx2(const char* str) {
+  size_t offset = reinterpret_cast<uintptr_t>(str) % kAvx2Width;
+  const char* block = str - offset;
+  uint32_t mask = ZeroMaskAvx2(LoadAvx2(block)) & (~0u << offset);
+  while (mask == 0) {
+    block += kAvx2Width;
+    if (IsChunkStart(block)) {
+      while (!ChunkHasZeroAvx2(block)) {
+        block += 4 * kAvx2Width;
+      }
+    }
+    mask = ZeroMaskAvx2(LoadAvx2(block));
+  }
+  return block + Lowest(mask) - str;
+}
+
+__attribute__((target("avx2"))) CSTRING_NO_SANITIZE_ADDRESS const char* StrchrAvx2(const char* str, char symbol) {
+  const __m256i pattern = _mm256_set1_epi8(symbol);
+  size_t offset = reinterpret_cast<uintptr_t>(str) % kAvx2Width;
+  const char* block = str - offset;
+  uint32_t mask = ZeroMaskAvx2(ZeroOrMatchAvx2(LoadAvx2(block), pattern)) & (~0u << offset);
+  while (mask == 0) {
+    block += kAvx2Width;
+    if (IsChunkStart(block)) {
+      while (!ChunkHasZeroOrMatchAvx2(block, pattern)) {
+        block += 4 * kAvx2Width;
+      }
+    }
+    mask = ZeroMaskAvx2(ZeroOrMatchAvx2(LoadAvx2(block), pattern));
+  }
+  const char* found = block + Lowest(mask);
+  return (*found == symbol ? found : nullptr);
+}
+
+__attribute__((target("avx2"))) CSTRING_NO_SANITIZE_ADDRESS const char* StrrchrAvx2(const char* str, char symbol) {
+  if (symbol == '\0') {
+    return str + StrlenAvx2(str);
+  }
+  const __m256i pattern = _mm256_set1_epi8(symbol);
+  size_t offset = reinterpret_cast<uintptr_t>(str) % kAvx2Width;
+  const char* block = str - offset;
+  const char* last = nullptr;
+  uint32_t first_bits = ~0u << offset;
+  for (;; block += kAvx2Width, first_bits = ~0u) {
+    // Chunks without a match or a terminator cannot change the answer.
+    if (first_bits == ~0u && IsChunkStart(block)) {
+      while (!ChunkHasZeroOrMatchAvx2(block, pattern)) {
+        block += 4 * kAvx2Width;
+      }
+    }
+    __m256i data = LoadAvx2(block);
+    uint32_t zeros = ZeroMaskAvx2(data) & first_bits;
+    auto matches = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, pattern))) & first_bits;
+    if (zeros != 0) {
+      matches &= BelowLowest(zeros);
+    }
+    if (matches != 0) {
+      last = block + Highest(matches);
+    }
+    if (zeros != 0) {
+      return last;
+    }
+  }
+}
+
+const char* PrefilterSearchSse2(const char* haystack, size_t size, const char* needle, size_t needle_size) {
+  constexpr size_t kWidth = sizeof(__m128i);
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[needle_size - 1]);
+  size_t i = 0;
+  for (; i + kWidth + needle_size - 1 <= size; i += kWidth) {
+    __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+    __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needle_size - 1));
+    auto mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last))));
+    for (; mask != 0; mask &= mask - 1) {
+      const char* candidate = haystack + i + Lowest(mask);
+      if (Memcmp(candidate + 1, needle + 1, needle_size - 2) == 0) {
+        return candidate;
+      }
+    }
+  }
+  return PrefilterSearchScalar(haystack + i, size - i, needle, needle_size);
+}
+
+__attribute__((target("avx2"))) const char* PrefilterSearchAvx2(const char* haystack, size_t size,
+                                                                const char* needle, size_t needle_size) {
+  constexpr size_t kWidth = sizeof(__m256i);
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[needle_size - 1]);
+  size_t i = 0;
+  for (; i + kWidth + needle_size - 1 <= size; i += kWidth) {
+    __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+    __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + needle_size - 1));
+    auto mask = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+    for (; mask != 0; mask &= mask - 1) {
+      const char* candidate = haystack + i + Lowest(mask);
+      if (Memcmp(candidate + 1, needle + 1, needle_size - 2) == 0) {
+        return candidate;
+      }
+    }
+  }
+  return PrefilterSearchScalar(haystack + i, size - i, needle, needle_size);
+}
+
+// Length of the prefix of str whose bytes are all in set (in_set) or all outside it. A byte's
+// low nibble selects a row of the eight ASCII high nibbles that form set members with it, and
+// its high nibble selects the bit of that row, so sets of ASCII bytes classify 16 bytes with two
+// shuffles. The terminator must stop the span: outside the set for in_set, inside otherwise.
+__attribute__((target("ssse3"))) CSTRING_NO_SANITIZE_ADDRESS size_t SpanSsse3(const char* str, const ByteSet& set,
+                                                                             bool in_set) {
+  constexpr size_t kWidth = sizeof(__m128i);
+  alignas(16) unsigned char rows[kWidth] = {};
+  for (unsigned byte = 0; byte < 0x80; ++byte) {
+    if (set.Contains(static_cast<char>(byte))) {
+      rows[byte & 0x0F] |= static_cast<unsigned char>(1u << (byte >> 4));
+    }
+  }
+  const __m128i row_table = _mm_load_si128(reinterpret_cast<const __m128i*>(rows));
+  const __m128i bit_table = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i low_nibble = _mm_set1_epi8(0x0F);
+  const __m128i zero = _mm_setzero_si128();
+  const uint32_t flip = (in_set ? 0xFFFF : 0);
+  size_t offset = reinterpret_cast<uintptr_t>(str) % kWidth;
+  const char* block = str - offset;
+  uint32_t first_bits = ~0u << offset;
+  for (;; block += kWidth, first_bits = ~0u) {
+    __m128i data = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i row = _mm_shuffle_epi8(row_table, _mm_and_si128(data, low_nibble));
+    __m128i bit = _mm_shuffle_epi8(bit_table, _mm_and_si128(_mm_srli_epi16(data, 4), low_nibble));
+    auto outside = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), zero)));
+    uint32_t stops = (outside ^ flip ^ 0xFFFF) & first_bits;
+    if (stops != 0) {
+      return block + Lowest(stops) - str;
+    }
+  }
+}
+
+constexpr size_t kPageSize = 4096;
+
+// Span over a set of at most 16 members with pcmpistri, which compares each byte of a block against
+// every member at once. Tokenizer fields are short, and for them this avoids building a ByteSet on
+// every call.
+template <bool InSet>
+__attribute__((target("sse4.2"))) CSTRING_NO_SANITIZE_ADDRESS size_t ShortSetSpan(const char* str, const char* set,
+                                                                                  __m128i members) {
+  constexpr int kWidth = sizeof(__m128i);
+  // Bytes from the terminator on are invalid and never match, so the span mode also stops there.
+  constexpr int kMode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | (InSet ? _SIDD_NEGATIVE_POLARITY : 0);
+  const char* current = str;
+  // The first block is read unaligned unless that would cross into the next page; after it, blocks
+  // are aligned.
+  if (reinterpret_cast<uintptr_t>(current) % kPageSize > kPageSize - kWidth) {
+    for (; reinterpret_cast<uintptr_t>(current) % kWidth != 0; ++current) {
+      if (*current == '\0' || (std::strchr(set, *current) != nullptr) != InSet) {
+        return current - str;
+      }
+    }
+  }
+  while (true) {
+    __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+    int index = _mm_cmpistri(members, data, kMode);
+    if (index != kWidth) {
+      return current + index - str;
+    }
+    if (!InSet && _mm_cmpistrz(members, data, kMode)) {
+      auto zeros = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_setzero_si128())));
+      return current + Lowest(zeros) - str;
+    }
+    current = reinterpret_cast<const char*>((reinterpret_cast<uintptr_t>(current) + kWidth) & ~uintptr_t(kWidth - 1));
+  }
+}
+
+__attribute__((target("sse4.2"))) CSTRING_NO_SANITIZE_ADDRESS size_t ShortSetSpanSse42(const char* str, const char* set,
+                                                                                       bool in_set) {
+  constexpr size_t kWidth = sizeof(__m128i);
+  __m128i members;
+  if (reinterpret_cast<uintptr_t>(set) % kPageSize <= kPageSize - kWidth) {
+    members = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set));
+  } else {
+    alignas(16) char copy[kWidth] = {};
+    for (size_t i = 0; i < kWidth && set[i] != '\0'; ++i) {
+      copy[i] = set[i];
+    }
+    members = _mm_load_si128(reinterpret_cast<const __m128i*>(copy));
+  }
+  // Without a terminator in the block, the set is exactly 16 bytes long only if set[16] ends it.
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(members, _mm_setzero_si128())) == 0 && set[kWidth] != '\0') {
+    return kLongSet;
+  }
+  return (in_set ? ShortSetSpan<true>(str, set, members) : ShortSetSpan<false>(str, set, members));
+}
+#endif
+
+// Start of the lexicographically maximal suffix of needle, under the normal or the reversed byte
+// order, together with its period.
+ptrdiff_t MaximalSuffix(const unsigned char* needle, size_t size, bool reversed, size_t* period) {
+  ptrdiff_t suffix = -1;
+  size_t j = 0;
+  size_t k = 1;
+  size_t p = 1;
+  while (j + k < size) {
+    unsigned char a = needle[j + k];
+    unsigned char b = needle[suffix + k];
+    if (a == b) {
+      if (k == p) {
+        j += p;
+        k = 1;
+      } else {
+        ++k;
+      }
+    } else if ((a < b) != reversed) {
+      j += k;
+      k = 1;
+      p = j - suffix;
+    } else {
+      suffix = j;
+      j = suffix + 1;
+      k = p = 1;
+    }
+  }
+  *period = p;
+  return suffix;
+}
+
+// Crochemore-Perrin Two-Way search: O(size + needle_size) time and O(1) space.
+const char* TwoWaySearch(const char* haystack, size_t size, const char* needle, size_t needle_size) {
+  auto text = reinterpret_cast<const unsigned char*>(haystack);
+  auto pattern = reinterpret_cast<const unsigned char*>(needle);
+  auto length = static_cast<ptrdiff_t>(needle_size);
+  size_t period;
+  size_t reversed_period;
+  ptrdiff_t split = MaximalSuffix(pattern, needle_size, false, &period);
+  ptrdiff_t reversed_split = MaximalSuffix(pattern, needle_size, true, &reversed_period);
+  if (reversed_split > split) {
+    split = reversed_split;
+    period = reversed_period;
+  }
+  if (Memcmp(needle, needle + period, split + 1) == 0) {
+    // Periodic needle: remember how much of the left part already matched after a period shift.
+    ptrdiff_t memory = -1;
+    for (size_t j = 0; j <= size - needle_size;) {
+      ptrdiff_t i = std::max(split, memory) + 1;
+      while (i < length && pattern[i] == text[i + j]) {
+        ++i;
+      }
+      if (i < length) {
+        j += i - split;
+        memory = -1;
+        continue;
+      }
+      i = split;
+      while (i > memory && pattern[i] == text[i + j]) {
+        --i;
+      }
+      if (i <= memory) {
+        return haystack + j;
+      }
+      j += period;
+      memory = length - static_cast<ptrdiff_t>(period) - 1;
+    }
+  } else {
+    period = std::max(split + 1, length - split - 1) + 1;
+    for (size_t j = 0; j <= size - needle_size;) {
+      ptrdiff_t i = split + 1;
+      while (i < length && pattern[i] == text[i + j]) {
+        ++i;
+      }
+      if (i < length) {
+        j += i - split;
+        continue;
+      }
+      i = split;
+      while (i >= 0 && pattern[i] == text[i + j]) {
+        --i;
+      }
+      if (i < 0) {
+        return haystack + j;
+      }
+      j += period;
+    }
+  }
+  return nullptr;
+}
+
+// Implementations picked once for the running CPU.
+struct Dispatch {
+  size_t (*strlen)(const char*);
+  const char* (*strchr)(const char*, char);
+  const char* (*strrchr)(const char*, char);
+  const char* (*prefilter_search)(const char*, size_t, const char*, size_t);
+  size_t (*ascii_span)(const char*, const ByteSet&, bool);
+  size_t (*short_set_span)(const char*, const char*, bool);
+};
+
+Dispatch SelectImplementations() {
+#ifdef CSTRING_X86_SIMD
+  __builtin_cpu_init();
+  auto ascii_span = (__builtin_cpu_supports("ssse3") ? SpanSsse3 : nullptr);
+  auto short_set_span = (__builtin_cpu_supports("sse4.2") ? ShortSetSpanSse42 : nullptr);
+  if (__builtin_cpu_supports("avx2")) {
+    return {StrlenAvx2, StrchrAvx2, StrrchrAvx2, PrefilterSearchAvx2, ascii_span, short_set_span};
+  }
+  return {StrlenSse2, StrchrSse2, StrrchrSse2, PrefilterSearchSse2, ascii_span, short_set_span};
+#else
+  return {StrlenSwar, StrchrSwar, StrrchrSwar, PrefilterSearchScalar, nullptr, nullptr};
+#endif
+}
+
+const Dispatch& Implementations() {
+  static const Dispatch kDispatch = SelectImplementations();
+  return kDispatch;
+}
+
+const char* Search(const char* haystack, size_t size, const char* needle, size_t needle_size) {
+  if (needle_size > size) {
+    return nullptr;
+  }
+  if (needle_size <= kShortNeedle) {
+    return Implementations().prefilter_search(haystack, size, needle, needle_size);
+  }
+  return TwoWaySearch(haystack, size, needle, needle_size);
+}
+
+size_t Span(const char* str, const ByteSet& set, bool in_set) {
+  size_t i = 0;
+  for (; i < kScalarSpanPrefix; ++i) {
+    if (set.Contains(str[i]) != in_set) {
+      return i;
+    }
+  }
+  auto ascii_span = Implementations().ascii_span;
+  if (set.ascii && ascii_span != nullptr) {
+    return i + ascii_span(str + i, set, in_set);
+  }
+  while (set.Contains(str[i]) == in_set) {
+    ++i;
+  }
+  return i;
+}
+
+// Strspn (in_set) or Strcspn of str over the bytes of set.
+size_t SetSpan(const char* str, const char* set, bool in_set) {
+  auto short_set_span = Implementations().short_set_span;
+  if (short_set_span != nullptr) {
+    size_t span = short_set_span(str, set, in_set);
+    if (span != kLongSet) {
+      return span;
+    }
+  }
+  return Span(str, ByteSet(set, !in_set), in_set);
+}
+}  // namespace
+
+size_t Strlen(const char* str) {
+  return Implementations().strlen(str);
 }
 int Strcmp(const char* first, const char* second) {
   while ((*first != '\0') && (*first == *second)) {
@@ -37,11 +648,7 @@ int Strncmp(const char* first, const char* second, size_t count) {
   return 0;
 }
 char* Strcpy(char* dest, const char* src) {
-  char* dest_temp = dest;
-  while (*src != '\0') {
-    *dest_temp++ = *src++;
-  }
-  *dest_temp = *src;
+  StrcpyLen(dest, src);
   return dest;
 }
 char* Strncpy(char* dest, const char* src, size_t count) {
@@ -55,11 +662,7 @@ char* Strncpy(char* dest, const char* src, size_t count) {
   return dest - count;
 }
 char* Strcat(char* dest, const char* src) {
-  char* dest_temp = dest + Strlen(dest);
-  while (*src != '\0') {
-    *dest_temp++ = *src++;
-  }
-  *dest_temp = '\0';
+  StrcatAt(dest, Strlen(dest), src);
   return dest;
 }
 char* Strncat(char* dest, const char* src, size_t count) {
@@ -74,106 +677,70 @@ char* Strncat(char* dest, const char* src, size_t count) {
   return dest;
 }
 const char* Strchr(const char* str, char symbol) {
-  while (*str != '\0') {
-    if (*str == symbol) {
-      return str;
-    }
-    ++str;
-  }
-  if (*str == symbol) {
-    return str;
-  }
-  return nullptr;
+  return Implementations().strchr(str, symbol);
 }
 const char* Strrchr(const char* str, char symbol) {
-  size_t len_str = Strlen(str);
-  str = str + len_str;
-  for (size_t i = 0; i < len_str + 1; ++i) {
-    if (*str == symbol) {
-      return str;
-    }
-    --str;
-  }
-  return nullptr;
+  return Implementations().strrchr(str, symbol);
 }
 size_t Strspn(const char* dest, const char* src) {
-  size_t counter = 0;
-  while (*dest != '\0') {
-    size_t counter_temp = counter;
-    const char* src_temp = src;
-    while (*src_temp != '\0') {
-      if (*dest == *src_temp) {
-        counter += 1;
-        break;
-      }
-      ++src_temp;
-    }
-    if (counter == counter_temp) {
-      return counter;
-    }
-    ++dest;
-  }
-  return counter;
+  return SetSpan(dest, src, true);
 }
 size_t Strcspn(const char* dest, const char* src) {
-  size_t counter = 0;
-  while (*dest != '\0') {
-    size_t counter_temp = counter;
-    const char* src_temp = src;
-    while (*src_temp != '\0') {
-      if (*dest == *src_temp) {
-        counter += 1;
-        break;
-      }
-      ++src_temp;
-    }
-    if (counter > counter_temp) {
-      return counter_temp;
-    }
-    ++dest;
-    ++counter;
-  }
-  return counter;
+  return SetSpan(dest, src, false);
 }
 const char* Strpbrk(const char* dest, const char* breakset) {
-  while (*dest != '\0') {
-    const char* breakset_temp = breakset;
-    while (*breakset_temp != '\0') {
-      if (*dest == *breakset_temp) {
-        return dest;
-      }
-      ++breakset_temp;
-    }
-    ++dest;
-  }
-  return nullptr;
+  const char* found = dest + Strcspn(dest, breakset);
+  return (*found == '\0' ? nullptr : found);
 }
+// The haystack is measured first so that the search can use bounded, in-range loads.
 const char* Strstr(const char* str, const char* pattern) {
-  if (*pattern == '\0') {
+  if (pattern[0] == '\0') {
     return str;
   }
-  while (*str != '\0') {
-    if (*str == *pattern) {
-      const char* str_temp = str;
-      const char* pattern_temp = pattern;
-      while (*pattern_temp != '\0') {
-        if (*pattern_temp != *str_temp) {
-          break;
-        }
-        ++pattern_temp;
-        ++str_temp;
-        if (*pattern_temp == '\0') {
-          return str;
-        }
-        if (*str_temp == '\0') {
-          return nullptr;
-        }
-      }
-    }
-    ++str;
-    if (*str == '\0') {
-      return nullptr;
+  if (pattern[1] == '\0') {
+    return Strchr(str, pattern[0]);
+  }
+  return Search(str, Strlen(str), pattern, Strlen(pattern));
+}
+const char* Memchr(const char* str, char symbol, size_t count) {
+  uint64_t pattern = kOnes * static_cast<unsigned char>(symbol);
+  size_t i = 0;
+  while (i + sizeof(uint64_t) <= count && !HasZeroByte(LoadWord(str + i) ^ pattern)) {
+    i += sizeof(uint64_t);
+  }
+  for (; i < count; ++i) {
+    if (str[i] == symbol) {
+      return str + i;
     }
   }
   return nullptr;
-}
\ No newline at end of file
+}
+int Memcmp(const char* first, const char* second, size_t count) {
+  size_t i = 0;
+  while (i + sizeof(uint64_t) <= count && LoadWord(first + i) == LoadWord(second + i)) {
+    i += sizeof(uint64_t);
+  }
+  for (; i < count; ++i) {
+    if (first[i] != second[i]) {
+      return static_cast<unsigned char>(first[i]) - static_cast<unsigned char>(second[i]);
+    }
+  }
+  return 0;
+}
+const char* Memmem(const char* haystack, size_t size, const char* needle, size_t needle_size) {
+  if (needle_size == 0) {
+    return haystack;
+  }
+  if (needle_size == 1) {
+    return Memchr(haystack, needle[0], size);
+  }
+  return Search(haystack, size, needle, needle_size);
+}
+size_t StrcpyLen(char* dest, const char* src) {
+  size_t size = Strlen(src);
+  Memcpy(dest, src, size + 1);
+  return size;
+}
+size_t StrcatAt(char* dest, size_t dest_size, const char* src) {
+  return dest_size + StrcpyLen(dest + dest_size, src);
+}
@@ -2,6 +2,7 @@
 #define CSTRING_H_
 
 #include <cstdlib>
+#include <cstring>
 
 using std::size_t;
 
@@ -18,4 +19,20 @@ size_t Strspn(const char* dest, const char* src);
 size_t Strcspn(const char* dest, const char* src);
 const char* Strpbrk(const char* dest, const char* breakset);
 const char* Strstr(const char* str, const char* pattern);
+const char* Memchr(const char* str, char symbol, size_t count);
+int Memcmp(const char* first, const char* second, size_t count);
+// Inline over std::memcpy, so fixed-size copies are expanded by the compiler and large ones use the
+// vectorized libc routine.
+inline char* Memcpy(char* dest, const char* src, size_t count) {
+  if (count != 0) {
+    std::memcpy(dest, src, count);
+  }
+  return dest;
+}
+const char* Memmem(const char* haystack, size_t size, const char* needle, size_t needle_size);
+// Copies src with its terminator and returns its length.
+size_t StrcpyLen(char* dest, const char* src);
+// Appends src at dest + dest_size, where dest_size is the known length of dest, and returns the
+// new length.
+size_t StrcatAt(char* dest, size_t dest_size, const char* src);
 #endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef HASH_H_
+#define HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Seedable 64-bit hash of a byte range in the style of wyhash: 48 bytes per step in three
+// independent lanes for long inputs, one or two overlapping loads for inputs up to 16 bytes.
+
+inline constexpr uint64_t kHashSecret[4] = {0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+                                            0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL};
+
+// 64x64 -> 128-bit product, returned as its low and high halves.
+inline void HashMultiply(uint64_t* low, uint64_t* high) noexcept {
+#ifdef __SIZEOF_INT128__
+  __uint128_t product = static_cast<__uint128_t>(*low) * *high;
+  *low = static_cast<uint64_t>(product);
+  *high = static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t a_high = *low >> 32;
+  uint64_t a_low = static_cast<uint32_t>(*low);
+  uint64_t b_high = *high >> 32;
+  uint64_t b_low = static_cast<uint32_t>(*high);
+  uint64_t high_high = a_high * b_high;
+  uint64_t high_low = a_high * b_low;
+  uint64_t low_high = a_low * b_high;
+  uint64_t low_low = a_low * b_low;
+  uint64_t middle = (low_low >> 32) + static_cast<uint32_t>(high_low) + static_cast<uint32_t>(low_high);
+  *low = (middle << 32) | static_cast<uint32_t>(low_low);
+  *high = high_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+#endif
+}
+
+inline uint64_t HashLoad64(const unsigned char* ptr) noexcept {
+  uint64_t value;
+  std::memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+inline uint64_t HashLoad32(const unsigned char* ptr) noexcept {
+  uint32_t value;
+  std::memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+// First, middle and last byte of a 1-3 byte input.
+inline uint64_t HashLoad3(const unsigned char* ptr, size_t size) noexcept {
+  return (uint64_t(ptr[0]) << 16) | (uint64_t(ptr[size >> 1]) << 8) | ptr[size - 1];
+}
+
+inline uint64_t HashMix(uint64_t a, uint64_t b) noexcept {
+  HashMultiply(&a, &b);
+  return a ^ b;
+}
+
+inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0) noexcept {
+  auto ptr = static_cast<const unsigned char*>(data);
+  seed ^= HashMix(seed ^ kHashSecret[0], kHashSecret[1]);
+  uint64_t a;
+  uint64_t b;
+  if (size <= 16) {
+    if (size >= 4) {
+      size_t shift = (size >> 3) << 2;
+      a = (HashLoad32(ptr) << 32) | HashLoad32(ptr + shift);
+      b = (HashLoad32(ptr + size - 4) << 32) | HashLoad32(ptr + size - 4 - shift);
+    } else if (size > 0) {
+      a = HashLoad3(ptr, size);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t remaining = size;
+    if (remaining > 48) {
+      uint64_t lane1 = seed;
+      uint64_t lane2 = seed;
+      do {
+        seed = HashMix(HashLoad64(ptr) ^ kHashSecret[1], HashLoad64(ptr + 8) ^ seed);
+        lane1 = HashMix(HashLoad64(ptr + 16) ^ kHashSecret[2], HashLoad64(ptr + 24) ^ lane1);
+        lane2 = HashMix(HashLoad64(ptr + 32) ^ kHashSecret[3], HashLoad64(ptr + 40) ^ lane2);
+        ptr += 48;
+        remaining -= 48;
+      } while (remaining > 48);
+      seed ^= lane1 ^ lane2;
+    }
+    while (remaining > 16) {
+      seed = HashMix(HashLoad64(ptr) ^ kHashSecret[1], HashLoad64(ptr + 8) ^ seed);
+      ptr += 16;
+      remaining -= 16;
+    }
+    a = HashLoad64(ptr + remaining - 16);
+    b = HashLoad64(ptr + remaining - 8);
+  }
+  a ^= kHashSecret[1];
+  b ^= seed;
+  HashMultiply(&a, &b);
+  return HashMix(a ^ kHashSecret[0] ^ size, b ^ kHashSecret[1]);
+}
+#endif
@@ -0,0 +1,404 @@
+#ifndef MAPPED_VECTOR_H_
+#define MAPPED_VECTOR_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "vector.h"
+
+class MappedVectorError : public std::runtime_error {
+ public:
+  explicit MappedVectorError(const std::string& what) : std::runtime_error("MappedVectorError: " + what) {
+  }
+};
+
+enum class MapMode { kReadOnly, kReadWrite, kTruncate };
+
+// Vector of trivially copyable records stored in a file. The file starts with a 64-byte header
+// followed by the elements, so opening an existing file only maps it: nothing is read or parsed.
+// A kReadOnly vector is read through const access (a const reference or std::as_const); its
+// non-const accessors and mutators throw MappedVectorError instead of writing to a read-only page.
+template <typename T, class Growth = GeometricGrowth<>>
+class MappedVector {
+  static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores raw bytes of T");
+
+ private:
+  struct Header {
+    uint64_t magic;
+    uint64_t element_size;
+    uint64_t size;
+  };
+  static constexpr uint64_t kMagic = 0x524f544345564d4dULL;
+  static constexpr size_t kHeaderSize = 64;
+  static_assert(alignof(T) <= kHeaderSize, "MappedVector does not support over-aligned types");
+  int fd_;
+  char* mapping_;
+  size_t capacity_;
+  bool read_only_;
+  Header* GetHeader() const noexcept;
+  T* Elements() const noexcept;
+  void Map(size_t new_cap);
+  void CheckWritable() const;
+  void Close() noexcept;
+
+ public:
+  using Iterator = typename Vector<T>::Iterator;
+  using ConstIterator = typename Vector<T>::ConstIterator;
+  using ValueType = T;
+  using SizeType = size_t;
+
+  explicit MappedVector(const char* path, MapMode mode = MapMode::kReadWrite);
+  MappedVector(const MappedVector&) = delete;
+  MappedVector& operator=(const MappedVector&) = delete;
+  MappedVector(MappedVector&&) noexcept;
+  MappedVector& operator=(MappedVector&&) noexcept;
+  ~MappedVector();
+  size_t Size() const noexcept;
+  size_t Capacity() const noexcept;
+  bool Empty() const noexcept;
+  bool IsReadOnly() const noexcept;
+  T& operator[](size_t);
+  const T& operator[](size_t) const;
+  const T& At(size_t) const;
+  T& At(size_t);
+  T& Front();
+  const T& Front() const noexcept;
+  T& Back();
+  const T& Back() const noexcept;
+  T* Data();
+  const T* Data() const noexcept;
+  void Reserve(size_t);
+  void Resize(size_t);
+  void Resize(size_t, const T&);
+  void ShrinkToFit();
+  void Clear();
+  void PushBack(const T&);
+  template <typename... Args>
+  void EmplaceBack(Args&&... args);
+  void PopBack();
+  void Sync();
+
+  Iterator begin() {  // NOLINT
+    CheckWritable();
+    return Iterator(Elements());
+  }
+  ConstIterator begin() const {  // NOLINT
+    return ConstIterator(Elements());
+  }
+  Iterator end() {  // NOLINT
+    CheckWritable();
+    return Iterator(Elements() + Size());
+  }
+  ConstIterator end() const {  // NOLINT
+    return ConstIterator(Elements() + Size());
+  }
+  ConstIterator cbegin() const {  // NOLINT
+    return begin();
+  }
+  ConstIterator cend() const {  // NOLINT
+    return end();
+  }
+};
+
+template <typename T, class Growth>
+MappedVector<T, Growth>::MappedVector(const char* path, MapMode mode)
+    : fd_(-1), mapping_(nullptr), capacity_(0), read_only_(mode == MapMode::kReadOnly) {
+  int flags = (read_only_ ? O_RDONLY : O_RDWR | O_CREAT);
+  if (mode == MapMode::kTruncate) {
+    flags |= O_TRUNC;
+  }
+  fd_ = open(path, flags, 0644);
+  if (fd_ < 0) {
+    throw MappedVectorError(std::string("open ") + path + ": " + std::strerror(errno));
+  }
+  struct stat info {};
+  if (fstat(fd_, &info) != 0) {
+    Close();
+    throw MappedVectorError(std::string("fstat: ") + std::strerror(errno));
+  }
+  auto file_size = static_cast<size_t>(info.st_size);
+  try {
+    if (file_size == 0 && !read_only_) {
+      Map(0);
+      GetHeader()->magic = kMagic;
+      GetHeader()->element_size = sizeof(T);
+      GetHeader()->size = 0;
+      return;
+    }
+    if (file_size < kHeaderSize || (file_size - kHeaderSize) % sizeof(T) != 0) {
+      throw MappedVectorError(std::string(path) + " is not a MappedVector file");
+    }
+    Map((file_size - kHeaderSize) / sizeof(T));
+    if (GetHeader()->magic != kMagic || GetHeader()->element_size != sizeof(T) || GetHeader()->size > capacity_) {
+      throw MappedVectorError(std::string(path) + " has an incompatible header");
+    }
+  } catch (...) {
+    Close();
+    throw;
+  }
+}
+
+template <typename T, class Growth>
+MappedVector<T, Growth>::MappedVector(MappedVector&& other) noexcept
+    : fd_(other.fd_), mapping_(other.mapping_), capacity_(other.capacity_), read_only_(other.read_only_) {
+  other.fd_ = -1;
+  other.mapping_ = nullptr;
+  other.capacity_ = 0;
+}
+
+template <typename T, class Growth>
+MappedVector<T, Growth>& MappedVector<T, Growth>::operator=(MappedVector&& other) noexcept {
+  if (this != &other) {
+    Close();
+    fd_ = other.fd_;
+    mapping_ = other.mapping_;
+    capacity_ = other.capacity_;
+    read_only_ = other.read_only_;
+    other.fd_ = -1;
+    other.mapping_ = nullptr;
+    other.capacity_ = 0;
+  }
+  return *this;
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::Close() noexcept {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, kHeaderSize + capacity_ * sizeof(T));
+    mapping_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+template <typename T, class Growth>
+MappedVector<T, Growth>::~MappedVector() {
+  Close();
+}
+
+// Resizes the file to hold new_cap elements and maps it; the mapping may move. The file is grown
+// before the mapping and shrunk after it, so the mapping never extends past the end of the file,
+// where an access would raise SIGBUS.
+template <typename T, class Growth>
+void MappedVector<T, Growth>::Map(size_t new_cap) {
+  size_t old_length = kHeaderSize + capacity_ * sizeof(T);
+  size_t new_length = kHeaderSize + new_cap * sizeof(T);
+  bool resize_file = !read_only_ && (mapping_ == nullptr || new_cap != capacity_);
+  bool grow_file = resize_file && (mapping_ == nullptr || new_length > old_length);
+  if (grow_file && ftruncate(fd_, static_cast<off_t>(new_length)) != 0) {
+    throw MappedVectorError(std::string("ftruncate: ") + std::strerror(errno));
+  }
+  void* address = MAP_FAILED;
+  if (mapping_ == nullptr) {
+    int protection = (read_only_ ? PROT_READ : PROT_READ | PROT_WRITE);
+    address = mmap(nullptr, new_length, protection, MAP_SHARED, fd_, 0);
+  } else {
+#ifdef MREMAP_MAYMOVE
+    address = mremap(mapping_, old_length, new_length, MREMAP_MAYMOVE);
+#else
+    address = mmap(nullptr, new_length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (address != MAP_FAILED) {
+      munmap(mapping_, old_length);
+    }
+#endif
+  }
+  if (address == MAP_FAILED) {
+    int error = errno;
+    if (grow_file && mapping_ != nullptr) {
+      // Best effort: the old mapping is still valid either way.
+      static_cast<void>(ftruncate(fd_, static_cast<off_t>(old_length)));
+    }
+    throw MappedVectorError(std::string("mmap: ") + std::strerror(error));
+  }
+  mapping_ = static_cast<char*>(address);
+  capacity_ = new_cap;
+  if (resize_file && !grow_file && ftruncate(fd_, static_cast<off_t>(new_length)) != 0) {
+    // The smaller mapping is in place; the file just keeps its unused tail.
+    throw MappedVectorError(std::string("ftruncate: ") + std::strerror(errno));
+  }
+}
+
+template <typename T, class Growth>
+typename MappedVector<T, Growth>::Header* MappedVector<T, Growth>::GetHeader() const noexcept {
+  return reinterpret_cast<Header*>(mapping_);
+}
+
+template <typename T, class Growth>
+T* MappedVector<T, Growth>::Elements() const noexcept {
+  return (mapping_ == nullptr ? nullptr : reinterpret_cast<T*>(mapping_ + kHeaderSize));
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::CheckWritable() const {
+  if (read_only_) {
+    throw MappedVectorError("vector is mapped read-only");
+  }
+}
+
+template <typename T, class Growth>
+size_t MappedVector<T, Growth>::Size() const noexcept {
+  return (mapping_ == nullptr ? 0 : GetHeader()->size);
+}
+
+template <typename T, class Growth>
+size_t MappedVector<T, Growth>::Capacity() const noexcept {
+  return capacity_;
+}
+
+template <typename T, class Growth>
+bool MappedVector<T, Growth>::Empty() const noexcept {
+  return (Size() == 0);
+}
+
+template <typename T, class Growth>
+bool MappedVector<T, Growth>::IsReadOnly() const noexcept {
+  return read_only_;
+}
+
+template <typename T, class Growth>
+T& MappedVector<T, Growth>::operator[](size_t index) {
+  CheckWritable();
+  return Elements()[index];
+}
+
+template <typename T, class Growth>
+const T& MappedVector<T, Growth>::operator[](size_t index) const {
+  return Elements()[index];
+}
+
+template <typename T, class Growth>
+const T& MappedVector<T, Growth>::At(size_t index) const {
+  if (index >= Size()) {
+    throw VectorOutOfRange{};
+  }
+  return Elements()[index];
+}
+
+template <typename T, class Growth>
+T& MappedVector<T, Growth>::At(size_t index) {
+  CheckWritable();
+  if (index >= Size()) {
+    throw VectorOutOfRange{};
+  }
+  return Elements()[index];
+}
+
+template <typename T, class Growth>
+T& MappedVector<T, Growth>::Front() {
+  CheckWritable();
+  return Elements()[0];
+}
+
+template <typename T, class Growth>
+const T& MappedVector<T, Growth>::Front() const noexcept {
+  return Elements()[0];
+}
+
+template <typename T, class Growth>
+T& MappedVector<T, Growth>::Back() {
+  CheckWritable();
+  return Elements()[Size() - 1];
+}
+
+template <typename T, class Growth>
+const T& MappedVector<T, Growth>::Back() const noexcept {
+  return Elements()[Size() - 1];
+}
+
+template <typename T, class Growth>
+T* MappedVector<T, Growth>::Data() {
+  CheckWritable();
+  return Elements();
+}
+
+template <typename T, class Growth>
+const T* MappedVector<T, Growth>::Data() const noexcept {
+  return Elements();
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::Reserve(size_t new_cap) {
+  CheckWritable();
+  if (capacity_ < new_cap) {
+    Growth::OnReallocate(capacity_, new_cap, 0);
+    Map(new_cap);
+  }
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::Resize(size_t new_size) {
+  Resize(new_size, T());
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::Resize(size_t new_size, const T& value) {
+  CheckWritable();
+  size_t size = Size();
+  if (new_size > capacity_) {
+    T copy = value;
+    Reserve(Growth::NextCapacity(capacity_, new_size, sizeof(T)));
+    std::uninitialized_fill(Elements() + size, Elements() + new_size, copy);
+  } else if (new_size > size) {
+    std::uninitialized_fill(Elements() + size, Elements() + new_size, value);
+  }
+  GetHeader()->size = new_size;
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::ShrinkToFit() {
+  CheckWritable();
+  if (capacity_ != Size()) {
+    Growth::OnReallocate(capacity_, Size(), 0);
+    Map(Size());
+  }
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::Clear() {
+  CheckWritable();
+  GetHeader()->size = 0;
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::PushBack(const T& value) {
+  EmplaceBack(value);
+}
+
+template <typename T, class Growth>
+template <typename... Args>
+void MappedVector<T, Growth>::EmplaceBack(Args&&... args) {
+  CheckWritable();
+  size_t size = Size();
+  if (size == capacity_) {
+    T value(std::forward<Args>(args)...);
+    Reserve(Growth::NextCapacity(capacity_, size + 1, sizeof(T)));
+    new (Elements() + size) T(value);
+  } else {
+    new (Elements() + size) T(std::forward<Args>(args)...);
+  }
+  GetHeader()->size = size + 1;
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::PopBack() {
+  CheckWritable();
+  --GetHeader()->size;
+}
+
+template <typename T, class Growth>
+void MappedVector<T, Growth>::Sync() {
+  if (!read_only_ && msync(mapping_, kHeaderSize + capacity_ * sizeof(T), MS_SYNC) != 0) {
+    throw MappedVectorError(std::string("msync: ") + std::strerror(errno));
+  }
+}
+
+#endif
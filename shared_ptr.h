@@ -4,6 +4,7 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <type_traits>
 #include <stdexcept>
 
 template <class T>
@@ -32,6 +33,7 @@ class SharedPtr {
   Counter* counter_;
 
  public:
+  using TriviallyRelocatable = std::true_type;
   SharedPtr();
   explicit SharedPtr(const WeakPtr<T>& weak_ptr);
   SharedPtr(T* ptr);                     // NOLINT
@@ -170,6 +172,7 @@ class WeakPtr {
   T* weak_ptr_;
 
  public:
+  using TriviallyRelocatable = std::true_type;
   WeakPtr();
   WeakPtr(const WeakPtr& other);  // NOLINT
   WeakPtr(WeakPtr&& other) noexcept;
@@ -0,0 +1,482 @@
+#ifndef SMALL_VECTOR_H_
+#define SMALL_VECTOR_H_
+
+#include "vector.h"
+
+// Vector with inline storage for the first N elements; it spills to the heap only when it grows past N.
+template <typename T, size_t N, class Growth = GeometricGrowth<>>
+class SmallVector {
+  static_assert(N > 0, "SmallVector needs at least one inline slot");
+
+ private:
+  T* vector_;
+  size_t size_;
+  size_t capacity_;
+  alignas(T) unsigned char buffer_[N * sizeof(T)];
+  T* Inline() noexcept;
+  void Reallocate(size_t);
+  void StealFrom(SmallVector&&);
+  void Release() noexcept;
+  template <typename... Args>
+  void EmplaceBackHelper(size_t, Args&&...);
+
+ public:
+  using Iterator = typename Vector<T>::Iterator;
+  using ConstIterator = typename Vector<T>::ConstIterator;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using ValueType = T;
+  using SizeType = size_t;
+
+  SmallVector() noexcept;
+  explicit SmallVector(size_t);
+  SmallVector(size_t, const T&);
+  template <class It, class = std::enable_if_t<std::is_base_of<
+                          std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>>
+  SmallVector(It, It);
+  SmallVector(std::initializer_list<T>);  // NOLINT
+  SmallVector(const SmallVector&);
+  SmallVector(SmallVector&&) noexcept(std::is_nothrow_move_constructible_v<T>);
+  SmallVector& operator=(const SmallVector&);
+  SmallVector& operator=(SmallVector&&) noexcept(std::is_nothrow_move_constructible_v<T>);
+  ~SmallVector();
+  size_t Size() const noexcept;
+  size_t Capacity() const noexcept;
+  bool Empty() const noexcept;
+  bool IsInline() const noexcept;
+  T& operator[](size_t);
+  const T& operator[](size_t) const;
+  const T& At(size_t) const;
+  T& At(size_t);
+  T& Front() noexcept;
+  const T& Front() const noexcept;
+  T& Back() noexcept;
+  const T& Back() const noexcept;
+  T* Data() noexcept;
+  const T* Data() const noexcept;
+  void Swap(SmallVector&) noexcept(std::is_nothrow_move_constructible_v<T>);
+  void Resize(size_t);
+  void Resize(size_t, const T&);
+  void Reserve(size_t);
+  void ShrinkToFit();
+  void Clear() noexcept;
+  void PushBack(const T&);
+  void PushBack(T&&);
+  void PopBack();
+  template <typename... Args>
+  void EmplaceBack(Args&&... args);
+
+  Iterator begin() {  // NOLINT
+    return Iterator(vector_);
+  }
+  ConstIterator begin() const {  // NOLINT
+    return ConstIterator(vector_);
+  }
+  Iterator end() {  // NOLINT
+    return Iterator(vector_ + size_);
+  }
+  ConstIterator end() const {  // NOLINT
+    return ConstIterator(vector_ + size_);
+  }
+  ConstIterator cbegin() const {  // NOLINT
+    return begin();
+  }
+  ConstIterator cend() const {  // NOLINT
+    return end();
+  }
+  ReverseIterator rbegin() {  // NOLINT
+    return std::make_reverse_iterator(end());
+  }
+  ConstReverseIterator rbegin() const {  // NOLINT
+    return std::make_reverse_iterator(end());
+  }
+  ReverseIterator rend() {  // NOLINT
+    return std::make_reverse_iterator(begin());
+  }
+  ConstReverseIterator rend() const {  // NOLINT
+    return std::make_reverse_iterator(begin());
+  }
+  ConstReverseIterator crbegin() const {  // NOLINT
+    return rbegin();
+  }
+  ConstReverseIterator crend() const {  // NOLINT
+    return rend();
+  }
+};
+
+template <typename T, size_t N, class Growth>
+T* SmallVector<T, N, Growth>::Inline() noexcept {
+  return reinterpret_cast<T*>(buffer_);
+}
+
+template <typename T, size_t N, class Growth>
+bool SmallVector<T, N, Growth>::IsInline() const noexcept {
+  return vector_ == reinterpret_cast<const T*>(buffer_);
+}
+
+template <typename T, size_t N, class Growth>
+SmallVector<T, N, Growth>::SmallVector() noexcept : vector_(Inline()), size_(0), capacity_(N) {
+}
+
+template <typename T, size_t N, class Growth>
+SmallVector<T, N, Growth>::SmallVector(size_t size) : SmallVector() {
+  Resize(size);
+}
+
+template <typename T, size_t N, class Growth>
+SmallVector<T, N, Growth>::SmallVector(size_t size, const T& value) : SmallVector() {
+  Resize(size, value);
+}
+
+template <typename T, size_t N, class Growth>
+template <class It, class>
+SmallVector<T, N, Growth>::SmallVector(It it_begin, It it_end) : SmallVector() {
+  Reserve(std::distance(it_begin, it_end));
+  try {
+    for (auto it = it_begin; it != it_end; ++it) {
+      new (vector_ + size_) T(*it);
+      ++size_;
+    }
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+template <typename T, size_t N, class Growth>
+SmallVector<T, N, Growth>::SmallVector(std::initializer_list<T> list) : SmallVector(list.begin(), list.end()) {
+}
+
+template <typename T, size_t N, class Growth>
+SmallVector<T, N, Growth>::SmallVector(const SmallVector& other) : SmallVector() {
+  Reserve(other.size_);
+  try {
+    TransferArray(vector_, other.vector_, other.size_);
+  } catch (...) {
+    Release();
+    throw;
+  }
+  size_ = other.size_;
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::StealFrom(SmallVector&& other) {
+  if (other.IsInline()) {
+    RelocateArray(vector_, other.vector_, other.size_);
+    size_ = other.size_;
+  } else {
+    vector_ = other.vector_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.vector_ = other.Inline();
+    other.capacity_ = N;
+  }
+  other.size_ = 0;
+}
+
+template <typename T, size_t N, class Growth>
+SmallVector<T, N, Growth>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    : SmallVector() {
+  StealFrom(std::move(other));
+}
+
+template <typename T, size_t N, class Growth>
+SmallVector<T, N, Growth>& SmallVector<T, N, Growth>::operator=(const SmallVector& other) {
+  if (this != &other) {
+    SmallVector copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T, size_t N, class Growth>
+SmallVector<T, N, Growth>& SmallVector<T, N, Growth>::operator=(SmallVector&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+  if (this != &other) {
+    Release();
+    StealFrom(std::move(other));
+  }
+  return *this;
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::Release() noexcept {
+  Clear();
+  if (!IsInline()) {
+    std::allocator<T>().deallocate(vector_, capacity_);
+    vector_ = Inline();
+    capacity_ = N;
+  }
+}
+
+template <typename T, size_t N, class Growth>
+SmallVector<T, N, Growth>::~SmallVector() {
+  Release();
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::Reallocate(size_t new_cap) {
+  Growth::OnReallocate(IsInline() ? 0 : capacity_, new_cap, size_ * sizeof(T));
+  T* vector_temp = (new_cap <= N ? Inline() : std::allocator<T>().allocate(new_cap));
+  try {
+    RelocateArray(vector_temp, vector_, size_);
+  } catch (...) {
+    if (vector_temp != Inline()) {
+      std::allocator<T>().deallocate(vector_temp, new_cap);
+    }
+    throw;
+  }
+  if (!IsInline()) {
+    std::allocator<T>().deallocate(vector_, capacity_);
+  }
+  vector_ = vector_temp;
+  capacity_ = (new_cap <= N ? N : new_cap);
+}
+
+template <typename T, size_t N, class Growth>
+size_t SmallVector<T, N, Growth>::Size() const noexcept {
+  return size_;
+}
+
+template <typename T, size_t N, class Growth>
+size_t SmallVector<T, N, Growth>::Capacity() const noexcept {
+  return capacity_;
+}
+
+template <typename T, size_t N, class Growth>
+bool SmallVector<T, N, Growth>::Empty() const noexcept {
+  return (size_ == 0);
+}
+
+template <typename T, size_t N, class Growth>
+T& SmallVector<T, N, Growth>::operator[](size_t index) {
+  return vector_[index];
+}
+
+template <typename T, size_t N, class Growth>
+const T& SmallVector<T, N, Growth>::operator[](size_t index) const {
+  return vector_[index];
+}
+
+template <typename T, size_t N, class Growth>
+const T& SmallVector<T, N, Growth>::At(size_t index) const {
+  if (index >= size_) {
+    throw VectorOutOfRange{};
+  }
+  return vector_[index];
+}
+
+template <typename T, size_t N, class Growth>
+T& SmallVector<T, N, Growth>::At(size_t index) {
+  if (index >= size_) {
+    throw VectorOutOfRange{};
+  }
+  return vector_[index];
+}
+
+template <typename T, size_t N, class Growth>
+T& SmallVector<T, N, Growth>::Front() noexcept {
+  return *vector_;
+}
+
+template <typename T, size_t N, class Growth>
+const T& SmallVector<T, N, Growth>::Front() const noexcept {
+  return *vector_;
+}
+
+template <typename T, size_t N, class Growth>
+T& SmallVector<T, N, Growth>::Back() noexcept {
+  return vector_[size_ - 1];
+}
+
+template <typename T, size_t N, class Growth>
+const T& SmallVector<T, N, Growth>::Back() const noexcept {
+  return vector_[size_ - 1];
+}
+
+template <typename T, size_t N, class Growth>
+T* SmallVector<T, N, Growth>::Data() noexcept {
+  return vector_;
+}
+
+template <typename T, size_t N, class Growth>
+const T* SmallVector<T, N, Growth>::Data() const noexcept {
+  return vector_;
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::Swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+  SmallVector temp(std::move(other));
+  other = std::move(*this);
+  *this = std::move(temp);
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::Reserve(size_t new_cap) {
+  if (capacity_ < new_cap) {
+    Reallocate(new_cap);
+  }
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::Resize(size_t new_size) {
+  if (size_ >= new_size) {
+    for (size_t i = new_size; i < size_; ++i) {
+      vector_[i].~T();
+    }
+    size_ = new_size;
+    return;
+  }
+  if (capacity_ < new_size) {
+    Reallocate(Growth::NextCapacity(capacity_, new_size, sizeof(T)));
+  }
+  size_t index = size_;
+  try {
+    for (; index < new_size; ++index) {
+      new (vector_ + index) T();
+    }
+  } catch (...) {
+    for (size_t i = size_; i < index; ++i) {
+      vector_[i].~T();
+    }
+    throw;
+  }
+  size_ = new_size;
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::Resize(size_t new_size, const T& value) {
+  if (size_ >= new_size) {
+    for (size_t i = new_size; i < size_; ++i) {
+      vector_[i].~T();
+    }
+    size_ = new_size;
+    return;
+  }
+  const T* source = &value;
+  if (capacity_ < new_size) {
+    std::less<const T*> less;
+    bool is_inside = !less(source, vector_) && less(source, vector_ + size_);
+    size_t offset = (is_inside ? source - vector_ : 0);
+    Reallocate(Growth::NextCapacity(capacity_, new_size, sizeof(T)));
+    if (is_inside) {
+      source = vector_ + offset;
+    }
+  }
+  size_t index = size_;
+  try {
+    for (; index < new_size; ++index) {
+      new (vector_ + index) T(*source);
+    }
+  } catch (...) {
+    for (size_t i = size_; i < index; ++i) {
+      vector_[i].~T();
+    }
+    throw;
+  }
+  size_ = new_size;
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::ShrinkToFit() {
+  if (!IsInline() && capacity_ != size_) {
+    Reallocate(size_);
+  }
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::Clear() noexcept {
+  for (size_t i = 0; i < size_; ++i) {
+    vector_[i].~T();
+  }
+  size_ = 0;
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::PushBack(const T& value) {
+  EmplaceBack(value);
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::PushBack(T&& value) {
+  EmplaceBack(std::move(value));
+}
+
+template <typename T, size_t N, class Growth>
+void SmallVector<T, N, Growth>::PopBack() {
+  vector_[size_ - 1].~T();
+  --size_;
+}
+
+template <typename T, size_t N, class Growth>
+template <typename... Args>
+void SmallVector<T, N, Growth>::EmplaceBackHelper(size_t new_cap, Args&&... args) {
+  Growth::OnReallocate(IsInline() ? 0 : capacity_, new_cap, size_ * sizeof(T));
+  auto vector_temp = std::allocator<T>().allocate(new_cap);
+  try {
+    new (vector_temp + size_) T(std::forward<Args>(args)...);
+  } catch (...) {
+    std::allocator<T>().deallocate(vector_temp, new_cap);
+    throw;
+  }
+  try {
+    RelocateArray(vector_temp, vector_, size_);
+  } catch (...) {
+    vector_temp[size_].~T();
+    std::allocator<T>().deallocate(vector_temp, new_cap);
+    throw;
+  }
+  if (!IsInline()) {
+    std::allocator<T>().deallocate(vector_, capacity_);
+  }
+  vector_ = vector_temp;
+  capacity_ = new_cap;
+  size_ += 1;
+}
+
+template <typename T, size_t N, class Growth>
+template <typename... Args>
+void SmallVector<T, N, Growth>::EmplaceBack(Args&&... args) {
+  if (size_ == capacity_) {
+    EmplaceBackHelper(Growth::NextCapacity(capacity_, size_ + 1, sizeof(T)), std::forward<Args>(args)...);
+  } else {
+    new (vector_ + size_) T(std::forward<Args>(args)...);
+    size_ += 1;
+  }
+}
+
+template <typename T, size_t N, class Growth>
+bool operator<(const SmallVector<T, N, Growth>& vector1, const SmallVector<T, N, Growth>& vector2) {
+  return ArraysLess(vector1.Data(), vector1.Size(), vector2.Data(), vector2.Size());
+}
+
+template <typename T, size_t N, class Growth>
+bool operator==(const SmallVector<T, N, Growth>& vector1, const SmallVector<T, N, Growth>& vector2) {
+  return ArraysEqual(vector1.Data(), vector1.Size(), vector2.Data(), vector2.Size());
+}
+
+template <typename T, size_t N, class Growth>
+bool operator!=(const SmallVector<T, N, Growth>& vector1, const SmallVector<T, N, Growth>& vector2) {
+  return !(vector1 == vector2);
+}
+
+template <typename T, size_t N, class Growth>
+bool operator>(const SmallVector<T, N, Growth>& vector1, const SmallVector<T, N, Growth>& vector2) {
+  return vector2 < vector1;
+}
+
+template <typename T, size_t N, class Growth>
+bool operator<=(const SmallVector<T, N, Growth>& vector1, const SmallVector<T, N, Growth>& vector2) {
+  return !(vector2 < vector1);
+}
+
+template <typename T, size_t N, class Growth>
+bool operator>=(const SmallVector<T, N, Growth>& vector1, const SmallVector<T, N, Growth>& vector2) {
+  return !(vector1 < vector2);
+}
+
+#endif
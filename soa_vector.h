@@ -0,0 +1,271 @@
+#ifndef SOA_VECTOR_H_
+#define SOA_VECTOR_H_
+
+#include <tuple>
+
+#include "vector_view.h"
+
+// Structure-of-arrays container: every field lives in its own Vector, so a loop over one column
+// reads only that column's bytes. Rows are accessed through tuples of references.
+template <typename... Fields>
+class SoAVector {
+  static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+ private:
+  static constexpr size_t kRowSize = (sizeof(Fields) + ...);
+  std::tuple<Vector<Fields>...> columns_;
+  template <size_t... I, typename... Args>
+  void EmplaceBackHelper(std::index_sequence<I...>, Args&&...);
+  template <size_t... I>
+  void ResizeHelper(std::index_sequence<I...>, size_t);
+  template <size_t... I>
+  void ReserveHelper(std::index_sequence<I...>, size_t);
+
+ public:
+  template <size_t I>
+  using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+  using Reference = std::tuple<Fields&...>;
+  using ConstReference = std::tuple<const Fields&...>;
+  template <bool IsConst>
+  class common_iterator;  // NOLINT
+  using Iterator = common_iterator<false>;
+  using ConstIterator = common_iterator<true>;
+
+  size_t Size() const noexcept;
+  size_t Capacity() const noexcept;
+  bool Empty() const noexcept;
+  Reference operator[](size_t);
+  ConstReference operator[](size_t) const;
+  template <size_t I>
+  FieldType<I>& Get(size_t);
+  template <size_t I>
+  const FieldType<I>& Get(size_t) const;
+  template <size_t I>
+  VectorView<FieldType<I>> Column();
+  template <size_t I>
+  VectorView<const FieldType<I>> Column() const;
+  void Reserve(size_t);
+  void Resize(size_t);
+  void ShrinkToFit();
+  void Clear();
+  template <typename... Args>
+  void PushBack(Args&&...);
+  void PopBack();
+
+  Iterator begin() {  // NOLINT
+    return Iterator(this, 0);
+  }
+  ConstIterator begin() const {  // NOLINT
+    return ConstIterator(this, 0);
+  }
+  Iterator end() {  // NOLINT
+    return Iterator(this, Size());
+  }
+  ConstIterator end() const {  // NOLINT
+    return ConstIterator(this, Size());
+  }
+
+  // Proxy iterator: dereferencing yields a tuple of references into the columns, built on the fly.
+  // It supports index arithmetic and reading or assigning through *it, but it is tagged as an input
+  // iterator: the proxy is not swappable, so algorithms that permute elements through *it
+  // (std::sort, std::reverse, ...) are not supported.
+  template <bool IsConst>
+  class common_iterator {  // NOLINT
+   private:
+    using Container = std::conditional_t<IsConst, const SoAVector, SoAVector>;
+    Container* container_;
+    int64_t index_;
+
+   public:
+    using reference = std::conditional_t<IsConst, ConstReference, Reference>;  // NOLINT
+    using value_type = std::tuple<Fields...>;                                  // NOLINT
+    using pointer = void;                                                      // NOLINT
+    using difference_type = int64_t;                                           // NOLINT
+    using iterator_category = std::input_iterator_tag;                         // NOLINT
+
+    common_iterator(Container* container, int64_t index) : container_(container), index_(index) {
+    }
+
+    reference operator*() const {
+      return (*container_)[index_];
+    }
+    reference operator[](int64_t offset) const {
+      return (*container_)[index_ + offset];
+    }
+    common_iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    common_iterator operator++(int) {
+      common_iterator copy = *this;
+      ++index_;
+      return copy;
+    }
+    common_iterator& operator--() {
+      --index_;
+      return *this;
+    }
+    common_iterator operator--(int) {
+      common_iterator copy = *this;
+      --index_;
+      return copy;
+    }
+    common_iterator& operator+=(int64_t n) {
+      index_ += n;
+      return *this;
+    }
+    common_iterator& operator-=(int64_t n) {
+      index_ -= n;
+      return *this;
+    }
+    common_iterator operator+(int64_t n) const {
+      return common_iterator(container_, index_ + n);
+    }
+    common_iterator operator-(int64_t n) const {
+      return common_iterator(container_, index_ - n);
+    }
+    int64_t operator-(const common_iterator& it) const {
+      return index_ - it.index_;
+    }
+    bool operator==(const common_iterator& it) const {
+      return index_ == it.index_;
+    }
+    bool operator!=(const common_iterator& it) const {
+      return index_ != it.index_;
+    }
+    bool operator<(const common_iterator& it) const {
+      return index_ < it.index_;
+    }
+    bool operator>(const common_iterator& it) const {
+      return it < *this;
+    }
+    bool operator<=(const common_iterator& it) const {
+      return !(it < *this);
+    }
+    bool operator>=(const common_iterator& it) const {
+      return !(*this < it);
+    }
+  };
+};
+
+template <typename... Fields>
+size_t SoAVector<Fields...>::Size() const noexcept {
+  return std::get<0>(columns_).Size();
+}
+
+template <typename... Fields>
+size_t SoAVector<Fields...>::Capacity() const noexcept {
+  return std::apply([](const auto&... column) { return std::min({column.Capacity()...}); }, columns_);
+}
+
+template <typename... Fields>
+bool SoAVector<Fields...>::Empty() const noexcept {
+  return (Size() == 0);
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::Reference SoAVector<Fields...>::operator[](size_t index) {
+  return std::apply([index](auto&... column) { return Reference(column[index]...); }, columns_);
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::ConstReference SoAVector<Fields...>::operator[](size_t index) const {
+  return std::apply([index](const auto&... column) { return ConstReference(column[index]...); }, columns_);
+}
+
+template <typename... Fields>
+template <size_t I>
+typename SoAVector<Fields...>::template FieldType<I>& SoAVector<Fields...>::Get(size_t index) {
+  return std::get<I>(columns_)[index];
+}
+
+template <typename... Fields>
+template <size_t I>
+const typename SoAVector<Fields...>::template FieldType<I>& SoAVector<Fields...>::Get(size_t index) const {
+  return std::get<I>(columns_)[index];
+}
+
+template <typename... Fields>
+template <size_t I>
+VectorView<typename SoAVector<Fields...>::template FieldType<I>> SoAVector<Fields...>::Column() {
+  return VectorView<FieldType<I>>(std::get<I>(columns_));
+}
+
+template <typename... Fields>
+template <size_t I>
+VectorView<const typename SoAVector<Fields...>::template FieldType<I>> SoAVector<Fields...>::Column() const {
+  return VectorView<const FieldType<I>>(std::get<I>(columns_));
+}
+
+// Every column is reserved before any element is constructed, so a failed allocation leaves all
+// columns at the same size.
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::ReserveHelper(std::index_sequence<I...>, size_t new_cap) {
+  (std::get<I>(columns_).Reserve(new_cap), ...);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Reserve(size_t new_cap) {
+  ReserveHelper(std::index_sequence_for<Fields...>{}, new_cap);
+}
+
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::ResizeHelper(std::index_sequence<I...>, size_t new_size) {
+  size_t size = Size();
+  size_t resized = 0;
+  try {
+    ((std::get<I>(columns_).Resize(new_size), ++resized), ...);
+  } catch (...) {
+    ((I < resized ? std::get<I>(columns_).Resize(size) : void()), ...);
+    throw;
+  }
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Resize(size_t new_size) {
+  if (new_size > Capacity()) {
+    Reserve(GeometricGrowth<>::NextCapacity(Capacity(), new_size, kRowSize));
+  }
+  ResizeHelper(std::index_sequence_for<Fields...>{}, new_size);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::ShrinkToFit() {
+  std::apply([](auto&... column) { (column.ShrinkToFit(), ...); }, columns_);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Clear() {
+  std::apply([](auto&... column) { (column.Clear(), ...); }, columns_);
+}
+
+template <typename... Fields>
+template <size_t... I, typename... Args>
+void SoAVector<Fields...>::EmplaceBackHelper(std::index_sequence<I...>, Args&&... values) {
+  size_t pushed = 0;
+  try {
+    ((std::get<I>(columns_).EmplaceBack(std::forward<Args>(values)), ++pushed), ...);
+  } catch (...) {
+    ((I < pushed ? std::get<I>(columns_).PopBack() : void()), ...);
+    throw;
+  }
+}
+
+template <typename... Fields>
+template <typename... Args>
+void SoAVector<Fields...>::PushBack(Args&&... values) {
+  static_assert(sizeof...(Args) == sizeof...(Fields), "PushBack takes one value per field");
+  if (Size() == Capacity()) {
+    Reserve(GeometricGrowth<>::NextCapacity(Capacity(), Size() + 1, kRowSize));
+  }
+  EmplaceBackHelper(std::index_sequence_for<Fields...>{}, std::forward<Args>(values)...);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::PopBack() {
+  std::apply([](auto&... column) { (column.PopBack(), ...); }, columns_);
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "../allocator.h"
+#include "../cow_vector.h"
+#include "../small_vector.h"
+#include "../vector_view.h"
+#include "test.h"
+
+namespace {
+// Copies share one buffer until one of them writes.
+void TestDetach() {
+  CowVector<std::string> original{"a", "b", "c"};
+  CowVector<std::string> copy = original;
+  CHECK(original.IsShared() && copy.IsShared());
+  CHECK(original.Data() == copy.Data());
+
+  copy.PushBack("d");
+  CHECK(!original.IsShared() && !copy.IsShared());
+  CHECK(original.Data() != copy.Data());
+  CHECK(original.Size() == 3 && copy.Size() == 4 && copy.Back() == "d");
+
+  CowVector<std::string> snapshot = copy;
+  size_t size = snapshot.Update([](Vector<std::string>& vector) {
+    vector[0] = "changed";
+    return vector.Size();
+  });
+  CHECK(size == 4);
+  CHECK(snapshot[0] == "changed" && copy[0] == "a");
+
+  // Writing to an unshared buffer keeps it.
+  const std::string* data = snapshot.Data();
+  snapshot.PopBack();
+  snapshot.EmplaceBack(3, 'x');
+  CHECK(snapshot.Data() == data && snapshot.Back() == "xxx");
+
+  CowVector<std::string> cleared = snapshot;
+  cleared.Clear();
+  CHECK(cleared.Empty() && snapshot.Size() == 4);
+  cleared.Resize(2);
+  CHECK(cleared.Size() == 2 && cleared[1].empty());
+}
+
+void TestEmpty() {
+  CowVector<int> empty;
+  CHECK(empty.Size() == 0 && empty.Empty() && !empty.IsShared());
+  CHECK(empty.begin() == empty.end());
+  CHECK(empty.View().Empty());
+  bool thrown = false;
+  try {
+    empty.At(0);
+  } catch (const VectorOutOfRange&) {
+    thrown = true;
+  }
+  CHECK(thrown);
+  CowVector<int> copy = empty;
+  copy.PushBack(1);
+  CHECK(empty.Empty() && copy.Size() == 1);
+}
+
+// A resource that counts live allocations, behind an allocator with no default constructor.
+struct CountingResource {
+  size_t live = 0;
+  void* Allocate(size_t bytes, size_t alignment) {
+    ++live;
+    return operator new(bytes, std::align_val_t(alignment));
+  }
+  void Deallocate(void* ptr, size_t, size_t alignment) noexcept {
+    --live;
+    operator delete(ptr, std::align_val_t(alignment));
+  }
+  void* Reallocate(void* ptr, size_t old_bytes, size_t new_bytes, size_t alignment) {
+    void* result = Allocate(new_bytes, alignment);
+    std::memcpy(result, ptr, std::min(old_bytes, new_bytes));
+    Deallocate(ptr, old_bytes, alignment);
+    return result;
+  }
+};
+
+using CountingAllocator = ResourceAllocator<int, CountingResource>;
+
+void TestStatefulAllocator() {
+  CountingResource resource;
+  {
+    CowVector<int, CountingAllocator> vector{{1, 2, 3}, CountingAllocator(&resource)};
+    CHECK(resource.live == 1);
+    CowVector<int, CountingAllocator> copy = vector;
+    copy.PushBack(4);
+    CHECK(resource.live == 2);
+    CHECK(copy.GetAllocator() == vector.GetAllocator());
+
+    CowVector<int, CountingAllocator> late{CountingAllocator(&resource)};
+    late.PushBack(5);
+    CHECK(resource.live == 3);
+    CHECK(late.GetAllocator().GetResource() == &resource);
+
+    Vector<int, CountingAllocator> source{CountingAllocator(&resource)};
+    source.PushBack(6);
+    CowVector<int, CountingAllocator> adopted(std::move(source));
+    CHECK(resource.live == 4 && adopted[0] == 6);
+  }
+  CHECK(resource.live == 0);
+}
+
+void TestVectorView() {
+  Vector<int> vector{0, 1, 2, 3, 4, 5, 6, 7};
+  VectorView<int> all(vector);
+  CHECK(all.Size() == 8 && all.Data() == vector.Data());
+  VectorView<int> middle = all.Subview(2, 3);
+  CHECK(middle.Size() == 3 && middle[0] == 2 && middle.Back() == 4);
+  middle[1] = 30;
+  CHECK(vector[3] == 30);
+  CHECK(all.Subview(6, 100).Size() == 2);
+  CHECK(all.First(3).Back() == 2 && all.Last(2).Front() == 6 && all.Last(20).Size() == 8);
+  bool thrown = false;
+  try {
+    all.Subview(9, 1);
+  } catch (const VectorOutOfRange&) {
+    thrown = true;
+  }
+  CHECK(thrown);
+
+  const Vector<int>& const_vector = vector;
+  VectorView<const int> read_only(const_vector);
+  CHECK(read_only == all);
+  CHECK(read_only.Subview(1, 2) != all.Subview(2, 2));
+  int sum = 0;
+  for (int value : read_only.Last(3)) {
+    sum += value;
+  }
+  CHECK(sum == 18);
+  CHECK(*read_only.rbegin() == 7);
+
+  SmallVector<int, 4> small{1, 2};
+  VectorView<int> small_view(small);
+  CHECK(small_view.Size() == 2 && small_view[1] == 2);
+}
+}  // namespace
+
+int main() {
+  TestDetach();
+  TestEmpty();
+  TestStatefulAllocator();
+  TestVectorView();
+  return 0;
+}
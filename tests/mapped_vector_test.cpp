@@ -0,0 +1,143 @@
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "../mapped_vector.h"
+#include "../vector_view.h"
+#include "test.h"
+
+namespace {
+struct Record {
+  uint64_t id;
+  double value;
+};
+
+std::string TempPath(const char* name) {
+  const char* directory = std::getenv("TMPDIR");
+  return std::string(directory != nullptr ? directory : "/tmp") + "/" + name + "." + std::to_string(getpid());
+}
+
+size_t FileSize(const std::string& path) {
+  struct stat info {};
+  CHECK(stat(path.c_str(), &info) == 0);
+  return static_cast<size_t>(info.st_size);
+}
+
+template <class Function>
+bool Throws(Function function) {
+  try {
+    function();
+  } catch (const MappedVectorError&) {
+    return true;
+  }
+  return false;
+}
+
+// Records written by one MappedVector are there, unchanged, when the file is opened again.
+void TestReopen(const std::string& path) {
+  {
+    MappedVector<Record> vector(path.c_str(), MapMode::kTruncate);
+    CHECK(vector.Empty() && !vector.IsReadOnly());
+    for (uint64_t i = 0; i < 1000; ++i) {
+      vector.PushBack(Record{i, static_cast<double>(i) / 4});
+    }
+    vector.Sync();
+  }
+  {
+    MappedVector<Record> vector(path.c_str());
+    CHECK(vector.Size() == 1000);
+    CHECK(vector[999].id == 999 && vector[999].value == 999.0 / 4);
+    vector.Resize(1200, Record{7, 7});
+    vector.EmplaceBack(Record{8, 8});
+    vector.PopBack();
+    CHECK(vector.Back().id == 7);
+  }
+  MappedVector<Record> vector(path.c_str());
+  CHECK(vector.Size() == 1200);
+  uint64_t sum = 0;
+  for (const auto& record : vector) {
+    sum += record.id;
+  }
+  CHECK(sum == 999 * 1000 / 2 + 200 * 7);
+
+  MappedVector<Record> moved(std::move(vector));
+  CHECK(moved.Size() == 1200 && moved[0].id == 0);
+}
+
+// Shrinking truncates the file after the mapping shrank, growing extends it before.
+void TestFileFollowsCapacity(const std::string& path) {
+  MappedVector<Record> vector(path.c_str());
+  size_t header = FileSize(path) - vector.Capacity() * sizeof(Record);
+  vector.Reserve(100000);
+  CHECK(FileSize(path) == header + 100000 * sizeof(Record));
+  vector.Resize(10);
+  vector.ShrinkToFit();
+  CHECK(vector.Capacity() == 10);
+  CHECK(FileSize(path) == header + 10 * sizeof(Record));
+  CHECK(vector[9].id == 9);
+  vector.Reserve(20);
+  vector[15] = Record{15, 1.5};
+  CHECK(vector[15].id == 15);
+}
+
+// Read-only vectors are read through const access; anything that could write throws.
+void TestReadOnly(const std::string& path) {
+  MappedVector<Record> vector(path.c_str(), MapMode::kReadOnly);
+  const MappedVector<Record>& view = vector;
+  CHECK(vector.IsReadOnly());
+  CHECK(view.Size() == 10 && view[9].id == 9 && view.At(9).id == 9);
+  CHECK(view.Front().id == 0 && view.Back().id == 9 && view.Data()[1].id == 1);
+  uint64_t sum = 0;
+  for (auto it = vector.cbegin(); it != vector.cend(); ++it) {
+    sum += it->id;
+  }
+  CHECK(sum == 45);
+  VectorView<const Record> slice(vector);
+  CHECK(slice.Size() == 10 && slice[3].id == 3);
+
+  CHECK(Throws([&] { vector[0].id = 1; }));
+  CHECK(Throws([&] { vector.At(0); }));
+  CHECK(Throws([&] { vector.Front(); }));
+  CHECK(Throws([&] { vector.Back(); }));
+  CHECK(Throws([&] { vector.Data(); }));
+  CHECK(Throws([&] { vector.begin(); }));
+  CHECK(Throws([&] { VectorView<Record> writable(vector); }));
+  CHECK(Throws([&] { vector.PushBack(Record{1, 1}); }));
+  CHECK(Throws([&] { vector.Resize(20); }));
+  CHECK(Throws([&] { vector.Clear(); }));
+  CHECK(Throws([&] { vector.ShrinkToFit(); }));
+  CHECK(view.Size() == 10);
+}
+
+void TestRejectsForeignFiles(const std::string& path) {
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  CHECK(file != nullptr);
+  std::fputs("not a mapped vector", file);
+  std::fclose(file);
+  CHECK(Throws([&] { MappedVector<Record> vector(path.c_str()); }));
+  {
+    MappedVector<uint32_t> vector(path.c_str(), MapMode::kTruncate);
+    vector.PushBack(1);
+    vector.PushBack(2);
+    vector.ShrinkToFit();
+  }
+  // Same file length as one Record, but the header names a different element size.
+  CHECK(Throws([&] { MappedVector<Record> vector(path.c_str()); }));
+  CHECK(Throws([&] { MappedVector<Record> vector((path + ".missing").c_str(), MapMode::kReadOnly); }));
+}
+}  // namespace
+
+int main() {
+  std::string path = TempPath("mapped_vector_test");
+  TestReopen(path);
+  TestFileFollowsCapacity(path);
+  TestReadOnly(path);
+  TestRejectsForeignFiles(path);
+  std::remove(path.c_str());
+  return 0;
+}
@@ -0,0 +1,99 @@
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "../String/rope.h"
+#include "test.h"
+
+namespace {
+size_t CountChunks(const Rope& rope) {
+  size_t chunks = 0;
+  rope.ForEachChunk([&chunks](StringView) { ++chunks; });
+  return chunks;
+}
+
+// An AVL tree with n leaves is at most about 1.44 * log2(n + 2) deep.
+bool DepthIsLogarithmic(const Rope& rope) {
+  double leaves = static_cast<double>(CountChunks(rope));
+  return static_cast<double>(rope.Depth()) <= 1.45 * std::log2(leaves + 2);
+}
+
+std::string ToStd(const Rope& rope) {
+  String string = rope.ToString();
+  return std::string(string.Data(), string.Size());
+}
+
+// 1e5 appends of pieces too long to be merged into the last leaf: every append links a new leaf,
+// which used to trigger a full rebuild every few dozen appends. The tree must stay AVL-shaped with
+// one leaf per piece; the time it takes is measured in bench/rope_bench.cpp.
+void TestManyAppends() {
+  constexpr size_t kPieces = 100000;
+  std::string piece(300, 'x');
+  Rope rope;
+  for (size_t i = 0; i < kPieces; ++i) {
+    piece[0] = static_cast<char>('a' + i % 26);
+    rope += Rope(StringView(piece.data(), piece.size()));
+  }
+  CHECK(rope.Size() == kPieces * piece.size());
+  CHECK(CountChunks(rope) == kPieces);
+  CHECK(DepthIsLogarithmic(rope));
+  CHECK(rope[0] == 'a' && rope[300] == 'b' && rope[(kPieces - 1) * 300] == 'a' + (kPieces - 1) % 26);
+  CHECK(rope[kPieces * 300 - 1] == 'x');
+
+  Rope prepended;
+  for (size_t i = 0; i < kPieces / 10; ++i) {
+    prepended = Rope(StringView(piece.data(), piece.size())) + prepended;
+  }
+  CHECK(DepthIsLogarithmic(prepended));
+  CHECK(DepthIsLogarithmic(prepended + rope) && DepthIsLogarithmic(rope + prepended));
+}
+
+// Short appends keep extending the last leaf rather than adding nodes.
+void TestShortAppendsMerge() {
+  Rope rope(StringView(std::string(1000, 'y').c_str()));
+  for (int i = 0; i < 1000; ++i) {
+    rope += Rope(StringView("0123456789", 10));
+  }
+  CHECK(rope.Size() == 11000);
+  CHECK(CountChunks(rope) <= 1 + 10000 / 200);
+  CHECK(rope.Substr(10995).ToString() == String("56789"));
+}
+
+void TestAgainstModel() {
+  std::mt19937 random(17);
+  for (int round = 0; round < 50; ++round) {
+    Rope rope;
+    std::string model;
+    for (int step = 0; step < 300; ++step) {
+      size_t kind = random() % 4;
+      std::string piece(random() % (kind == 0 ? 800 : 300), static_cast<char>('a' + random() % 26));
+      Rope other(StringView(piece.data(), piece.size()));
+      if (kind == 0) {
+        rope = other + rope;
+        model = piece + model;
+      } else if (kind == 1 && !model.empty()) {
+        size_t position = random() % model.size();
+        size_t count = random() % (model.size() - position + 5);
+        rope = rope.Substr(position, count);
+        model = model.substr(position, count);
+      } else {
+        rope += other;
+        model += piece;
+      }
+      CHECK(rope.Size() == model.size());
+      CHECK(DepthIsLogarithmic(rope));
+    }
+    CHECK(ToStd(rope) == model);
+    Rope doubled = rope + rope;
+    CHECK(ToStd(doubled) == model + model);
+    CHECK(DepthIsLogarithmic(doubled));
+  }
+}
+}  // namespace
+
+int main() {
+  TestManyAppends();
+  TestShortAppendsMerge();
+  TestAgainstModel();
+  return 0;
+}
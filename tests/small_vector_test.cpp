@@ -0,0 +1,144 @@
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "../small_vector.h"
+#include "test.h"
+
+namespace {
+size_t heap_allocations = 0;
+}  // namespace
+
+// Every heap allocation in this executable goes through here, so inline storage can be checked
+// directly.
+void* operator new(size_t size) {
+  ++heap_allocations;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+void TestStaysInline() {
+  size_t before = heap_allocations;
+  SmallVector<int, 8> vector;
+  CHECK(vector.IsInline() && vector.Capacity() == 8);
+  for (int i = 0; i < 8; ++i) {
+    vector.PushBack(i);
+  }
+  SmallVector<int, 8> copy(vector);
+  SmallVector<int, 8> moved(std::move(copy));
+  moved.Resize(4);
+  moved.Resize(8, 3);
+  SmallVector<int, 8> list{1, 2, 3};
+  CHECK(heap_allocations == before);
+  CHECK(vector.IsInline() && moved.IsInline() && list.IsInline());
+  CHECK(moved[3] == 3 && moved[4] == 3 && moved[7] == 3);
+
+  vector.PushBack(8);
+  CHECK(heap_allocations == before + 1);
+  CHECK(!vector.IsInline() && vector.Capacity() >= 9);
+  for (int i = 0; i < 9; ++i) {
+    CHECK(vector[i] == i);
+  }
+  vector.PopBack();
+  vector.ShrinkToFit();
+  CHECK(vector.IsInline() && vector.Size() == 8 && vector.Back() == 7);
+}
+
+std::string Long(size_t i) {
+  return "element " + std::to_string(i) + " with a heap allocated buffer";
+}
+
+bool Holds(const SmallVector<std::string, 4>& vector, size_t count) {
+  if (vector.Size() != count) {
+    return false;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (vector[i] != Long(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+SmallVector<std::string, 4> Make(size_t count) {
+  SmallVector<std::string, 4> vector;
+  for (size_t i = 0; i < count; ++i) {
+    vector.PushBack(Long(i));
+  }
+  return vector;
+}
+
+// Copy, move and swap across every inline/heap combination.
+void TestOwnership() {
+  for (size_t first : {0, 3, 4, 5, 20}) {
+    for (size_t second : {0, 2, 4, 9}) {
+      SmallVector<std::string, 4> a = Make(first);
+      SmallVector<std::string, 4> b = Make(second);
+      a.Swap(b);
+      CHECK(Holds(a, second) && Holds(b, first));
+      a = b;
+      CHECK(Holds(a, first) && Holds(b, first));
+      SmallVector<std::string, 4> c(std::move(a));
+      CHECK(Holds(c, first) && a.Empty() && a.IsInline());
+      b = Make(second);
+      c = std::move(b);
+      CHECK(Holds(c, second) && b.Empty() && b.IsInline());
+    }
+  }
+}
+
+// The argument lives in the buffer being replaced when the inline slots run out.
+void TestPushOwnElement() {
+  SmallVector<std::string, 4> vector = Make(4);
+  vector.PushBack(vector[0]);
+  CHECK(vector.Size() == 5 && vector[4] == Long(0));
+  while (vector.Size() < vector.Capacity()) {
+    vector.PushBack(Long(0));
+  }
+  vector.PushBack(vector[1]);
+  CHECK(vector.Back() == Long(1));
+  SmallVector<std::string, 4> resized = Make(3);
+  resized.Resize(10, resized[2]);
+  CHECK(resized.Size() == 10 && resized[9] == Long(2));
+}
+
+void TestAccess() {
+  SmallVector<int, 2> vector{5, 6, 7};
+  CHECK(vector.At(2) == 7);
+  bool thrown = false;
+  try {
+    vector.At(3);
+  } catch (const VectorOutOfRange&) {
+    thrown = true;
+  }
+  CHECK(thrown);
+  int sum = 0;
+  for (int value : vector) {
+    sum += value;
+  }
+  CHECK(sum == 18);
+  CHECK(*vector.rbegin() == 7);
+  CHECK((SmallVector<int, 2>{1, 2} < SmallVector<int, 2>{1, 3}));
+  CHECK((SmallVector<int, 2>{1, 2, 3} == SmallVector<int, 2>{1, 2, 3}));
+}
+}  // namespace
+
+int main() {
+  TestStaysInline();
+  TestOwnership();
+  TestPushOwnElement();
+  TestAccess();
+  return 0;
+}
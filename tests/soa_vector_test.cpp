@@ -0,0 +1,125 @@
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "../soa_vector.h"
+#include "test.h"
+
+namespace {
+using Particles = SoAVector<int, double, std::string>;
+
+static_assert(std::is_same_v<std::iterator_traits<Particles::Iterator>::iterator_category, std::input_iterator_tag>);
+static_assert(std::is_same_v<Particles::FieldType<1>, double>);
+
+Particles Make(int count) {
+  Particles particles;
+  for (int i = 0; i < count; ++i) {
+    particles.PushBack(i, i * 0.5, "p" + std::to_string(i));
+  }
+  return particles;
+}
+
+void TestRowsAndColumns() {
+  Particles particles = Make(100);
+  CHECK(particles.Size() == 100 && particles.Capacity() >= 100);
+  CHECK(particles.Get<0>(42) == 42 && particles.Get<1>(42) == 21.0 && particles.Get<2>(42) == "p42");
+
+  auto [id, mass, name] = particles[7];
+  CHECK(id == 7 && mass == 3.5 && name == "p7");
+  id = 70;
+  name += "!";
+  CHECK(particles.Get<0>(7) == 70 && particles.Get<2>(7) == "p7!");
+  particles[8] = std::make_tuple(80, 1.0, std::string("eighty"));
+  CHECK(particles.Get<0>(8) == 80 && particles.Get<2>(8) == "eighty");
+
+  // Each column is one contiguous array.
+  VectorView<double> masses = particles.Column<1>();
+  CHECK(masses.Size() == 100 && &masses[1] == &masses[0] + 1);
+  for (double& value : masses) {
+    value *= 2;
+  }
+  const Particles& view = particles;
+  double sum = 0;
+  for (double value : view.Column<1>()) {
+    sum += value;
+  }
+  // Twice i * 0.5 for every row but row 8, whose mass was set to 1.
+  CHECK(sum == 4950 - 8 + 2);
+  CHECK(std::get<2>(view[99]) == "p99");
+}
+
+void TestIteration() {
+  Particles particles = Make(10);
+  int64_t ids = 0;
+  for (auto it = particles.begin(); it != particles.end(); ++it) {
+    auto [id, mass, name] = *it;
+    ids += id;
+    mass = -1;
+  }
+  CHECK(ids == 45);
+  CHECK(particles.Get<1>(9) == -1);
+  const Particles& view = particles;
+  auto it = view.begin();
+  CHECK(std::get<2>(it[3]) == "p3");
+  it += 5;
+  CHECK(std::get<0>(*it) == 5 && view.end() - it == 5 && it < view.end());
+}
+
+void TestResize() {
+  Particles particles = Make(10);
+  particles.Resize(20);
+  CHECK(particles.Size() == 20 && particles.Get<0>(19) == 0 && particles.Get<2>(19).empty());
+  particles.PopBack();
+  particles.Resize(5);
+  CHECK(particles.Size() == 5 && particles.Get<2>(4) == "p4");
+  particles.ShrinkToFit();
+  CHECK(particles.Capacity() == 5);
+  particles.Clear();
+  CHECK(particles.Empty() && particles.Column<2>().Empty());
+}
+
+bool fail_copy = false;
+
+struct Fragile {
+  int value;
+  explicit Fragile(int v) : value(v) {
+  }
+  Fragile(const Fragile& other) : value(other.value) {
+    if (fail_copy) {
+      throw std::runtime_error("copy");
+    }
+  }
+  Fragile(Fragile&&) noexcept = default;
+};
+
+// A field that fails to construct takes back the fields already pushed, so columns stay aligned.
+void TestPushBackThrows() {
+  SoAVector<std::string, Fragile, int> rows;
+  rows.PushBack(std::string("a"), Fragile(1), 1);
+  Fragile fragile(2);
+  fail_copy = true;
+  bool thrown = false;
+  try {
+    rows.PushBack(std::string("b"), fragile, 2);
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  fail_copy = false;
+  CHECK(thrown);
+  CHECK(rows.Size() == 1);
+  CHECK(rows.Column<0>().Size() == 1 && rows.Column<1>().Size() == 1 && rows.Column<2>().Size() == 1);
+  rows.PushBack(std::string("c"), fragile, 3);
+  CHECK(rows.Get<0>(1) == "c" && rows.Get<1>(1).value == 2 && rows.Get<2>(1) == 3);
+}
+}  // namespace
+
+int main() {
+  TestRowsAndColumns();
+  TestIteration();
+  TestResize();
+  TestPushBackThrows();
+  return 0;
+}
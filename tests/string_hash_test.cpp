@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "../String/cppstring.h"
+#include "../String/string_view.h"
+#include "../hash.h"
+#include "../vector.h"
+#include "test.h"
+
+// Built twice: against strings as configured, and against strings_cached_hash, where String caches
+// its hash. Both must agree with hashing the current bytes after every kind of mutation.
+namespace {
+bool HashIsCurrent(const String& string) {
+  return string.Hash() == HashBytes(string.Data(), string.Size()) &&
+         string.Hash() == StringView(string.Data(), string.Size()).Hash() &&
+         std::hash<String>()(string) == static_cast<size_t>(string.Hash());
+}
+
+void TestLayout() {
+#ifdef STRING_CACHED_HASH
+  CHECK(sizeof(String) == 3 * sizeof(size_t) + sizeof(uint64_t));
+#else
+  CHECK(sizeof(String) == 3 * sizeof(size_t));
+#endif
+}
+
+void TestHashBytes() {
+  std::string bytes;
+  for (size_t size = 0; size < 200; ++size) {
+    CHECK(HashBytes(bytes.data(), size) == HashBytes(bytes.data(), size, 0));
+    CHECK(HashBytes(bytes.data(), size, 1) != HashBytes(bytes.data(), size, 2));
+    std::string copy = bytes;
+    if (size > 0) {
+      copy[size / 2] ^= 1;
+      CHECK(HashBytes(copy.data(), size) != HashBytes(bytes.data(), size));
+    }
+    bytes.push_back(static_cast<char>('a' + size % 26));
+  }
+  Vector<uint8_t> buffer;
+  for (uint8_t byte : {1, 2, 3, 250, 0, 7}) {
+    buffer.PushBack(byte);
+  }
+  Vector<uint8_t> same(buffer);
+  CHECK(std::hash<Vector<uint8_t>>()(buffer) == std::hash<Vector<uint8_t>>()(same));
+  same.Back() = 8;
+  CHECK(std::hash<Vector<uint8_t>>()(buffer) != std::hash<Vector<uint8_t>>()(same));
+}
+
+// Hash() between mutations fills the cache, so each mutation must clear it.
+void TestMutations() {
+  String string("short");
+  CHECK(HashIsCurrent(string));
+  string += "er than the inline capacity";
+  CHECK(HashIsCurrent(string));
+  string.PushBack('!');
+  CHECK(HashIsCurrent(string));
+  string.PopBack();
+  CHECK(HashIsCurrent(string));
+  string[0] = 'S';
+  CHECK(HashIsCurrent(string));
+  string.At(1) = 'H';
+  CHECK(HashIsCurrent(string));
+  string.Front() = 's';
+  CHECK(HashIsCurrent(string));
+  string.Back() = 'Y';
+  CHECK(HashIsCurrent(string));
+  string.Data()[2] = 'O';
+  CHECK(HashIsCurrent(string));
+  string.CStr()[3] = 'R';
+  CHECK(HashIsCurrent(string));
+  string.Resize(50, 'z');
+  CHECK(HashIsCurrent(string));
+  string.Reserve(500);
+  CHECK(HashIsCurrent(string));
+  string.ShrinkToFit();
+  CHECK(HashIsCurrent(string));
+  string.AppendInt(-42).AppendDouble(0.5);
+  CHECK(HashIsCurrent(string));
+  string.Clear();
+  CHECK(HashIsCurrent(string));
+
+  String other("other");
+  CHECK(HashIsCurrent(other));
+  string.Swap(other);
+  CHECK(HashIsCurrent(string) && HashIsCurrent(other));
+  string = other;
+  CHECK(HashIsCurrent(string) && string.Hash() == other.Hash());
+  String moved(std::move(string));
+  CHECK(HashIsCurrent(moved) && HashIsCurrent(string));
+  string = std::move(moved);
+  CHECK(HashIsCurrent(string) && HashIsCurrent(moved));
+  string = String("a string long enough to live on the heap");
+  CHECK(HashIsCurrent(string));
+}
+}  // namespace
+
+int main() {
+  TestLayout();
+  TestHashBytes();
+  TestMutations();
+  return 0;
+}
@@ -0,0 +1,26 @@
+#include "../String/cppstring.h"
+#include "../String/string_view.h"
+#include "test.h"
+
+// String and StringView order bytes as unsigned char, like memcmp and std::string, so UTF-8 text
+// sorts by code point. Before StringView existed, String compared plain char, which is signed on
+// x86, and sorted bytes >= 0x80 before ASCII.
+int main() {
+  CHECK(String("a") < String("\xc3\xa9"));
+  CHECK(!(String("\xc3\xa9") < String("a")));
+  CHECK(String("\xc3\xa9") > String("z"));
+  CHECK(String("\x7f") < String("\x80"));
+  CHECK(String("\xff") > String("\x80"));
+  CHECK(StringView("a") < StringView("\xc3\xa9"));
+  CHECK((String("\xc3\xa9") < String("a")) == (StringView("\xc3\xa9") < StringView("a")));
+
+  CHECK(String("abc") < String("abd"));
+  CHECK(String("ab") < String("abc"));
+  CHECK(String("") < String("a"));
+  CHECK(String("abc") == String("abc"));
+  CHECK(String("abc") != String("abC"));
+  CHECK(String("abc") <= String("abc") && String("abc") >= String("abc"));
+  CHECK(String("a\0b", 3) > String("a\0a", 3));
+  CHECK(String("a\0b", 3) != String("a", 1));
+  return 0;
+}
@@ -0,0 +1,17 @@
+#ifndef TESTS_TEST_H_
+#define TESTS_TEST_H_
+
+#include <cstdio>
+#include <cstdlib>
+
+// Each test executable is a plain main() that aborts on the first failed check; ctest reports the
+// non-zero exit.
+#define CHECK(condition)                                                                  \
+  do {                                                                                    \
+    if (!(condition)) {                                                                   \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      std::exit(1);                                                                       \
+    }                                                                                     \
+  } while (false)
+
+#endif
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../vector.h"
+#include "../vector_view.h"
+#include "test.h"
+
+namespace {
+enum class Color : uint8_t { kRed, kGreen, kBlue };
+
+template <class T>
+Vector<T> ToVector(const std::vector<T>& model) {
+  return Vector<T>(model.begin(), model.end());
+}
+
+// The element-wise order the memcmp paths must reproduce: decided by operator< at the first
+// element where operator!= holds. It matches std::vector's order except around NaN.
+template <class T>
+bool ReferenceLess(const std::vector<T>& model1, const std::vector<T>& model2) {
+  size_t min_size = std::min(model1.size(), model2.size());
+  for (size_t i = 0; i < min_size; ++i) {
+    if (model1[i] != model2[i]) {
+      return model1[i] < model2[i];
+    }
+  }
+  return model1.size() < model2.size();
+}
+
+template <class T>
+void CheckSameOrder(const std::vector<T>& model1, const std::vector<T>& model2) {
+  Vector<T> vector1 = ToVector(model1);
+  Vector<T> vector2 = ToVector(model2);
+  CHECK((vector1 == vector2) == (model1 == model2));
+  CHECK((vector1 != vector2) == (model1 != model2));
+  CHECK((vector1 < vector2) == ReferenceLess(model1, model2));
+  CHECK((vector1 > vector2) == ReferenceLess(model2, model1));
+  CHECK((vector1 <= vector2) == !ReferenceLess(model2, model1));
+  CHECK((vector1 >= vector2) == !ReferenceLess(model1, model2));
+  CHECK((VectorView<const T>(vector1) == VectorView<const T>(vector2)) == (model1 == model2));
+}
+
+// Pairs that differ in one element, placed around the 64-byte blocks the memcmp prefix skips, with
+// values that order differently as signed and unsigned.
+template <class T>
+void TestAgainstModel(std::vector<T> values) {
+  std::mt19937 random(13);
+  for (size_t size : {0, 1, 7, 8, 63, 64, 65, 127, 128, 129, 300}) {
+    std::vector<T> base(size);
+    for (size_t i = 0; i < size; ++i) {
+      base[i] = values[random() % values.size()];
+    }
+    CheckSameOrder(base, base);
+    std::vector<T> longer = base;
+    longer.push_back(values[0]);
+    CheckSameOrder(base, longer);
+    CheckSameOrder(longer, base);
+    for (size_t position : {size_t(0), size / 2, size - 1, size_t(63), size_t(64), size_t(65)}) {
+      if (position >= size) {
+        continue;
+      }
+      for (const auto& value : values) {
+        std::vector<T> changed = base;
+        changed[position] = value;
+        CheckSameOrder(base, changed);
+        CheckSameOrder(changed, base);
+        changed.pop_back();
+        CheckSameOrder(base, changed);
+      }
+    }
+  }
+}
+}  // namespace
+
+int main() {
+  TestAgainstModel<uint8_t>({0, 1, 0x7f, 0x80, 0xff});
+  TestAgainstModel<char>({0, 'a', 'z', '\x7f', '\x80', '\xff'});
+  TestAgainstModel<signed char>({0, 1, -1, 127, -128});
+  TestAgainstModel<int>({0, 1, -1, 256, -256, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()});
+  TestAgainstModel<uint16_t>({0, 1, 0x00ff, 0xff00, 0xffff});
+  TestAgainstModel<int64_t>({0, -1, int64_t(1) << 40, -(int64_t(1) << 40)});
+  TestAgainstModel<bool>({false, true});
+  TestAgainstModel<Color>({Color::kRed, Color::kGreen, Color::kBlue});
+  // Floating point equality is not byte equality: -0.0 == 0.0 and NaN != NaN, so doubles must stay
+  // off the memcmp paths.
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  TestAgainstModel<double>({0.0, -0.0, 1.5, -1.5, nan});
+  TestAgainstModel<std::string>({"", "a", "ab", "b"});
+
+  int objects[3] = {};
+  TestAgainstModel<const int*>({nullptr, objects, objects + 1, objects + 2});
+  return 0;
+}
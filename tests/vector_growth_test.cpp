@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <memory>
+
+#include "../vector.h"
+#include "test.h"
+
+namespace {
+void TestGeometricGrowth() {
+  using Doubling = GeometricGrowth<>;
+  // The first allocation fills a cache line.
+  CHECK(Doubling::NextCapacity(0, 1, 4) == kCacheLineSize / 4);
+  CHECK(Doubling::NextCapacity(0, 1, 200) == 1);
+  CHECK(Doubling::NextCapacity(0, 100, 4) == 100);
+  CHECK(Doubling::NextCapacity(16, 17, 4) == 32);
+  CHECK(Doubling::NextCapacity(16, 40, 4) == 40);
+
+  using OneAndHalf = GeometricGrowth<3, 2>;
+  CHECK(OneAndHalf::NextCapacity(16, 17, 4) == 24);
+  CHECK(OneAndHalf::NextCapacity(1, 2, 200) == 2);
+
+  // At and past the huge page threshold, buffers are rounded up to whole huge pages.
+  size_t huge = Doubling::NextCapacity(kHugePageSize / 8, kHugePageSize / 8 + 1, 6);
+  size_t pages = (huge * 6 + kHugePageSize - 1) / kHugePageSize;
+  CHECK(pages * kHugePageSize - huge * 6 < 6);
+  CHECK(huge >= kHugePageSize / 4);
+  using NoHugePages = GeometricGrowth<2, 1, 0>;
+  CHECK(NoHugePages::NextCapacity(kHugePageSize / 8, kHugePageSize / 8 + 1, 6) == kHugePageSize / 4);
+
+  // Multiplying would overflow, so only what is required is requested, and rounding to huge pages
+  // never wraps below it.
+  CHECK(NoHugePages::NextCapacity(SIZE_MAX / 2 + 1, SIZE_MAX / 2 + 2, 1) == SIZE_MAX / 2 + 2);
+  CHECK(Doubling::NextCapacity(SIZE_MAX / 2 + 1, SIZE_MAX / 2 + 2, 1) >= SIZE_MAX / 2 + 2);
+  CHECK(Doubling::NextCapacity(SIZE_MAX / 16, SIZE_MAX / 16 + 1, 8) >= SIZE_MAX / 16 + 1);
+}
+
+struct CountedTag;
+using Counted = CountedGrowth<GeometricGrowth<>, CountedTag>;
+
+// Replays the policy to know how many buffers pushing `count` ints goes through.
+void TestCountedGrowth() {
+  constexpr size_t kCount = 1000;
+  size_t reallocations = 0;
+  size_t bytes_copied = 0;
+  size_t capacity = 0;
+  for (size_t size = 0; size < kCount; ++size) {
+    if (size == capacity) {
+      if (capacity != 0) {
+        ++reallocations;
+        bytes_copied += size * sizeof(int);
+      }
+      capacity = GeometricGrowth<>::NextCapacity(capacity, size + 1, sizeof(int));
+    }
+  }
+
+  GrowthCounters& counters = Counted::Counters();
+  {
+    Vector<int, std::allocator<int>, Counted> vector;
+    for (size_t i = 0; i < kCount; ++i) {
+      vector.PushBack(static_cast<int>(i));
+    }
+    CHECK(vector.Capacity() == capacity);
+    CHECK(counters.allocations == 1);
+    CHECK(counters.reallocations == reallocations);
+    CHECK(counters.bytes_copied == bytes_copied);
+    CHECK(counters.peak_capacity == capacity);
+  }
+
+  // Counters are shared by every Vector with the same tag.
+  Vector<int, std::allocator<int>, Counted> other;
+  other.Reserve(4 * kCount);
+  CHECK(counters.allocations == 2);
+  CHECK(counters.reallocations == reallocations);
+  CHECK(counters.peak_capacity == 4 * kCount);
+  other.PushBack(1);
+  other.ShrinkToFit();
+  CHECK(counters.reallocations == reallocations + 1);
+  CHECK(counters.bytes_copied == bytes_copied + sizeof(int));
+  CHECK(counters.peak_capacity == 4 * kCount);
+
+  // A different tag counts separately.
+  using OtherCounted = CountedGrowth<GeometricGrowth<>, int>;
+  Vector<int, std::allocator<int>, OtherCounted> untracked;
+  untracked.PushBack(1);
+  CHECK(counters.allocations == 2);
+  CHECK(OtherCounted::Counters().allocations == 1);
+}
+
+// The growth policy is part of the type but not of the behaviour.
+void TestPolicyDoesNotChangeContents() {
+  Vector<int, std::allocator<int>, GeometricGrowth<3, 2, 0>> vector;
+  for (int i = 0; i < 500; ++i) {
+    vector.PushBack(i);
+  }
+  vector.Resize(1000, 7);
+  CHECK(vector.Size() == 1000);
+  for (int i = 0; i < 500; ++i) {
+    CHECK(vector[i] == i);
+    CHECK(vector[500 + i] == 7);
+  }
+}
+}  // namespace
+
+int main() {
+  TestGeometricGrowth();
+  TestCountedGrowth();
+  TestPolicyDoesNotChangeContents();
+  return 0;
+}
@@ -0,0 +1,170 @@
+#include <iterator>
+#include <list>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../String/cppstring.h"
+#include "../vector.h"
+#include "test.h"
+
+namespace {
+template <class T>
+T Make(size_t i);
+
+template <>
+int Make<int>(size_t i) {
+  return static_cast<int>(i);
+}
+
+template <>
+std::string Make<std::string>(size_t i) {
+  return "value " + std::to_string(i) + " long enough to allocate";
+}
+
+template <>
+String Make<String>(size_t i) {
+  return String(Make<std::string>(i).c_str());
+}
+
+template <class T>
+bool Same(const Vector<T>& vector, const std::vector<T>& model) {
+  if (vector.Size() != model.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < model.size(); ++i) {
+    if (!(vector[i] == model[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Random Append/Insert/Erase/EraseIf against std::vector. int and String take the memmove paths,
+// std::string the element-wise ones; insert counts cover both tail > count and tail <= count, with
+// and without reallocation.
+template <class T>
+void TestAgainstModel() {
+  std::mt19937 random(5);
+  Vector<T> vector;
+  std::vector<T> model;
+  size_t next = 0;
+  for (int step = 0; step < 3000; ++step) {
+    size_t kind = random() % 6;
+    size_t count = random() % (step % 50 == 0 ? 40 : 6);
+    std::list<T> source;
+    for (size_t i = 0; i < count; ++i) {
+      source.push_back(Make<T>(next++));
+    }
+    if (kind == 0) {
+      vector.Append(source.begin(), source.end());
+      model.insert(model.end(), source.begin(), source.end());
+    } else if (kind <= 2) {
+      size_t offset = random() % (model.size() + 1);
+      auto it = vector.Insert(vector.cbegin() + offset, source.begin(), source.end());
+      CHECK(it == vector.begin() + offset);
+      model.insert(model.begin() + offset, source.begin(), source.end());
+    } else if (kind == 3 && !model.empty()) {
+      size_t offset = random() % model.size();
+      auto it = vector.Erase(vector.cbegin() + offset);
+      CHECK(it == vector.begin() + offset);
+      model.erase(model.begin() + offset);
+    } else if (kind == 4 && !model.empty()) {
+      size_t first = random() % model.size();
+      size_t last = first + random() % (model.size() - first + 1);
+      vector.Erase(vector.cbegin() + first, vector.cbegin() + last);
+      model.erase(model.begin() + first, model.begin() + last);
+    } else if (kind == 5 && step % 10 == 0) {
+      size_t modulus = 2 + random() % 5;
+      size_t target = 0;
+      auto predicate = [&](const T&) { return target++ % modulus == 0; };
+      size_t erased = vector.EraseIf(predicate);
+      size_t model_size = model.size();
+      target = 0;
+      std::vector<T> kept;
+      for (auto& element : model) {
+        if (!predicate(element)) {
+          kept.push_back(element);
+        }
+      }
+      model.swap(kept);
+      CHECK(erased == model_size - model.size());
+    }
+    CHECK(Same(vector, model));
+  }
+}
+
+void TestAppendInputIterator() {
+  std::istringstream stream("1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20");
+  Vector<int> vector{0};
+  vector.Append(std::istream_iterator<int>(stream), std::istream_iterator<int>());
+  CHECK(vector.Size() == 21);
+  for (int i = 0; i <= 20; ++i) {
+    CHECK(vector[i] == i);
+  }
+}
+
+int copies_left = 0;
+int live = 0;
+
+struct ThrowingCopy {
+  int value;
+  explicit ThrowingCopy(int v) : value(v) {
+    ++live;
+  }
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (copies_left-- == 0) {
+      throw std::runtime_error("copy");
+    }
+    ++live;
+  }
+  ThrowingCopy(ThrowingCopy&& other) noexcept : value(other.value) {
+    ++live;
+  }
+  ThrowingCopy& operator=(const ThrowingCopy&) = default;
+  ThrowingCopy& operator=(ThrowingCopy&&) = default;
+  ~ThrowingCopy() {
+    --live;
+  }
+};
+
+// A copy that throws while inserting into a reallocated buffer leaves the vector as it was.
+void TestInsertThrows() {
+  {
+    Vector<ThrowingCopy> vector;
+    for (int i = 0; i < 4; ++i) {
+      vector.EmplaceBack(i);
+    }
+    vector.ShrinkToFit();
+    std::list<ThrowingCopy> source;
+    for (int i = 0; i < 5; ++i) {
+      source.emplace_back(100 + i);
+    }
+    copies_left = 3;
+    bool thrown = false;
+    try {
+      vector.Insert(vector.cbegin() + 2, source.begin(), source.end());
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(vector.Size() == 4);
+    for (int i = 0; i < 4; ++i) {
+      CHECK(vector[i].value == i);
+    }
+    CHECK(live == 9);
+  }
+  CHECK(live == 0);
+}
+}  // namespace
+
+int main() {
+  TestAgainstModel<int>();
+  TestAgainstModel<String>();
+  TestAgainstModel<std::string>();
+  TestAppendInputIterator();
+  TestInsertThrows();
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+#include "../vector.h"
+#include "../vector_parallel.h"
+#include "test.h"
+
+namespace {
+// Sizes below, at and above the point where construction is split into chunks.
+const size_t kSizes[] = {0, 1, 100, kParallelMinChunk, 2 * kParallelMinChunk - 1, 2 * kParallelMinChunk,
+                         4 * kParallelMinChunk + 7};
+
+bool AllEqual(const Vector<int>& vector, size_t size, int value) {
+  if (vector.Size() != size) {
+    return false;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    if (vector[i] != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TestResize(const ExecutionPolicy& policy) {
+  for (size_t size : kSizes) {
+    Vector<int> filled;
+    ParallelResize(filled, policy, size, 7);
+    CHECK(AllEqual(filled, size, 7));
+
+    Vector<int> defaulted(3, 5);
+    ParallelResize(defaulted, policy, size + 3);
+    CHECK(defaulted.Size() == size + 3);
+    CHECK(defaulted[0] == 5 && defaulted[2] == 5);
+    for (size_t i = 3; i < defaulted.Size(); ++i) {
+      CHECK(defaulted[i] == 0);
+    }
+
+    ParallelResize(filled, policy, size / 2, 9);
+    CHECK(AllEqual(filled, size / 2, 7));
+  }
+}
+
+void TestAppend(const ExecutionPolicy& policy) {
+  for (size_t size : kSizes) {
+    Vector<std::string> source;
+    for (size_t i = 0; i < size; ++i) {
+      source.PushBack(std::to_string(i));
+    }
+    Vector<std::string> copy;
+    copy.PushBack("head");
+    ParallelAppend(copy, policy, source.begin(), source.end());
+    CHECK(copy.Size() == size + 1);
+    CHECK(copy[0] == "head");
+    for (size_t i = 0; i < size; ++i) {
+      CHECK(copy[i + 1] == source[i]);
+    }
+  }
+}
+
+// Value being filled lives inside the vector that reallocates.
+void TestResizeFromOwnElement(const ExecutionPolicy& policy) {
+  Vector<std::string> vector(1, std::string(40, 'v'));
+  ParallelResize(vector, policy, 3 * kParallelMinChunk, vector[0]);
+  CHECK(vector.Size() == 3 * kParallelMinChunk);
+  CHECK(vector.Back() == std::string(40, 'v'));
+}
+
+std::atomic<size_t> constructed{0};
+std::atomic<size_t> live{0};
+
+struct Throwing {
+  Throwing() {
+    if (constructed++ == 3 * kParallelMinChunk) {
+      throw std::runtime_error("construct");
+    }
+    ++live;
+  }
+  ~Throwing() {
+    --live;
+  }
+};
+
+// A failing chunk must not leak the elements the other chunks constructed.
+void TestThrowingConstructor(const ExecutionPolicy& policy) {
+  Vector<Throwing> vector;
+  bool thrown = false;
+  try {
+    ParallelResize(vector, policy, 4 * kParallelMinChunk);
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  CHECK(thrown);
+  CHECK(vector.Empty());
+  CHECK(live == 0);
+}
+}  // namespace
+
+int main() {
+  ParallelPool pool(4);
+  CHECK(pool.Threads() == 4);
+  const ExecutionPolicy policies[] = {kSequential, kParallel, ExecutionPolicy{0, &pool}, ExecutionPolicy{3, &pool},
+                                      ExecutionPolicy{8, nullptr}};
+  for (const auto& policy : policies) {
+    TestResize(policy);
+    TestAppend(policy);
+    TestResizeFromOwnElement(policy);
+  }
+  TestThrowingConstructor(kSequential);
+  constructed = 0;
+  TestThrowingConstructor(ExecutionPolicy{4, &pool});
+  return 0;
+}
@@ -0,0 +1,131 @@
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "../vector.h"
+#include "test.h"
+
+namespace {
+// Single-pass source: every copy of the iterator reads from the same stream of values, so reading
+// the range twice would skip values and the contents would not match.
+class Generator {
+ public:
+  using iterator_category = std::input_iterator_tag;  // NOLINT
+  using value_type = std::string;                     // NOLINT
+  using difference_type = std::ptrdiff_t;             // NOLINT
+  using pointer = const std::string*;                 // NOLINT
+  using reference = const std::string&;               // NOLINT
+
+  Generator() = default;
+  Generator(std::shared_ptr<size_t> next, size_t end) : next_(std::move(next)), end_(end) {
+    Load();
+  }
+  reference operator*() const {
+    return current_;
+  }
+  Generator& operator++() {
+    ++*next_;
+    Load();
+    return *this;
+  }
+  bool operator==(const Generator& other) const {
+    return Done() == other.Done();
+  }
+  bool operator!=(const Generator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  std::shared_ptr<size_t> next_;
+  size_t end_ = 0;
+  std::string current_;
+  bool Done() const {
+    return next_ == nullptr || *next_ >= end_;
+  }
+  void Load() {
+    if (!Done()) {
+      current_ = "generated " + std::to_string(*next_);
+    }
+  }
+};
+
+void TestSinglePass() {
+  for (size_t count : {0, 1, 7, 1000}) {
+    auto next = std::make_shared<size_t>(0);
+    Vector<std::string> vector(Generator(next, count), Generator());
+    CHECK(vector.Size() == count);
+    CHECK(*next == count);
+    for (size_t i = 0; i < count; ++i) {
+      CHECK(vector[i] == "generated " + std::to_string(i));
+    }
+  }
+  std::istringstream stream("3 1 4 1 5 9 2 6");
+  Vector<int> digits{std::istream_iterator<int>(stream), std::istream_iterator<int>()};
+  CHECK(digits == (Vector<int>{3, 1, 4, 1, 5, 9, 2, 6}));
+}
+
+// Ranges that can be walked twice are counted first and allocated once, at the exact size.
+void TestCountedRanges() {
+  std::list<std::string> list{"a", "b", "c", "d", "e"};
+  Vector<std::string> from_list(list.begin(), list.end());
+  CHECK(from_list.Size() == 5 && from_list.Capacity() == 5);
+  CHECK(from_list[4] == "e");
+
+  int array[] = {1, 2, 3, 4, 5, 6, 7};
+  Vector<int> from_array(std::begin(array), std::end(array));
+  CHECK(from_array.Size() == 7 && from_array.Capacity() == 7 && from_array[6] == 7);
+
+  Vector<int> empty(array, array);
+  CHECK(empty.Empty() && empty.Capacity() == 0);
+
+  // Two integers are a count and a value, not a range.
+  Vector<size_t> counted(size_t(5), size_t(7));
+  CHECK(counted.Size() == 5 && counted[4] == 7);
+}
+
+int live = 0;
+int throw_after = -1;
+
+struct Fragile {
+  explicit Fragile(const std::string&) {
+    if (throw_after-- == 0) {
+      throw std::runtime_error("construct");
+    }
+    ++live;
+  }
+  Fragile(const Fragile&) {
+    ++live;
+  }
+  Fragile(Fragile&&) noexcept {
+    ++live;
+  }
+  ~Fragile() {
+    --live;
+  }
+};
+
+// A failed element in the single-pass path releases everything built so far.
+void TestSinglePassThrows() {
+  auto next = std::make_shared<size_t>(0);
+  throw_after = 100;
+  bool thrown = false;
+  try {
+    Vector<Fragile> vector(Generator(next, 1000), Generator());
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  CHECK(thrown);
+  CHECK(live == 0);
+}
+}  // namespace
+
+int main() {
+  TestSinglePass();
+  TestCountedRanges();
+  TestSinglePassThrows();
+  return 0;
+}
@@ -0,0 +1,119 @@
+#include <string>
+#include <utility>
+
+#include "../String/cppstring.h"
+#include "../allocator.h"
+#include "../vector.h"
+#include "test.h"
+
+namespace {
+// Holds a pointer to itself, so a bitwise move would leave it dangling. It does not opt in and must
+// be relocated with its move constructor.
+struct SelfReferencing {
+  SelfReferencing* self;
+  int value;
+
+  explicit SelfReferencing(int v) : self(this), value(v) {
+  }
+  SelfReferencing(const SelfReferencing& other) : self(this), value(other.value) {
+  }
+  SelfReferencing(SelfReferencing&& other) noexcept : self(this), value(other.value) {
+    other.value = -1;
+  }
+  SelfReferencing& operator=(const SelfReferencing& other) {
+    value = other.value;
+    return *this;
+  }
+  ~SelfReferencing() {
+    self = nullptr;
+  }
+};
+
+static_assert(kIsTriviallyRelocatableV<String>);
+static_assert(kIsTriviallyRelocatableV<int>);
+static_assert(!kIsTriviallyRelocatableV<SelfReferencing>);
+
+String Long(size_t i) {
+  return String(("element number " + std::to_string(i) + " kept on the heap").c_str());
+}
+
+// Grows through many reallocations; every push of v[0] happens when the buffer is full, so the
+// argument lives in the buffer being moved.
+template <class Alloc>
+void TestStrings(const Alloc& alloc) {
+  Vector<String, Alloc> vector(alloc);
+  for (size_t i = 0; i < 1000; ++i) {
+    if (vector.Size() == vector.Capacity() && !vector.Empty()) {
+      vector.PushBack(vector[0]);
+      CHECK(vector.Back() == vector[0]);
+    }
+    vector.PushBack(Long(i));
+    vector.EmplaceBack("short");
+  }
+  size_t next = 0;
+  for (size_t i = 0; i < vector.Size(); ++i) {
+    if (vector[i] == "short") {
+      continue;
+    }
+    if (vector[i] == vector[0] && i != 0) {
+      continue;
+    }
+    CHECK(vector[i] == Long(next));
+    ++next;
+  }
+  CHECK(next == 1000);
+
+  Vector<String, Alloc> short_strings(alloc);
+  for (size_t i = 0; i < 100; ++i) {
+    short_strings.PushBack(String("abc"));
+    short_strings.PushBack(short_strings[i]);
+  }
+  CHECK(short_strings.Size() == 200);
+  for (const auto& string : short_strings) {
+    CHECK(string == "abc");
+  }
+  vector.ShrinkToFit();
+  CHECK(vector.Capacity() == vector.Size());
+  CHECK(vector[1] == "short");
+}
+
+template <class Alloc>
+void TestSelfReferencing(const Alloc& alloc) {
+  Vector<SelfReferencing, Alloc> vector(alloc);
+  for (int i = 0; i < 1000; ++i) {
+    if (vector.Size() == vector.Capacity() && !vector.Empty()) {
+      vector.PushBack(vector[0]);
+      CHECK(vector.Back().value == 0);
+    }
+    vector.EmplaceBack(i);
+  }
+  int next = 0;
+  for (size_t i = 0; i < vector.Size(); ++i) {
+    CHECK(vector[i].self == &vector[i]);
+    if (i != 0 && vector[i].value == 0) {
+      continue;
+    }
+    CHECK(vector[i].value == next);
+    ++next;
+  }
+  CHECK(next == 1000);
+  vector.Reserve(vector.Capacity() * 2);
+  for (size_t i = 0; i < vector.Size(); ++i) {
+    CHECK(vector[i].self == &vector[i]);
+  }
+}
+}  // namespace
+
+int main() {
+  TestStrings(std::allocator<String>());
+  TestStrings(MallocAllocator<String>());
+  ArenaResource arena;
+  TestStrings(ArenaAllocator<String>(&arena));
+  PoolResource pool;
+  TestStrings(PoolAllocator<String>(&pool));
+
+  TestSelfReferencing(std::allocator<SelfReferencing>());
+  TestSelfReferencing(MallocAllocator<SelfReferencing>());
+  TestSelfReferencing(PoolAllocator<SelfReferencing>(&pool));
+  return 0;
+}
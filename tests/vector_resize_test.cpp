@@ -0,0 +1,93 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "../vector.h"
+#include "test.h"
+
+namespace {
+// Trivial elements are not written: bytes left in the reused capacity are still there, while
+// Resize value-initializes them.
+void TestTrivialElementsUntouched() {
+  Vector<unsigned char> buffer;
+  buffer.Resize(4096, 0xAB);
+  size_t capacity = buffer.Capacity();
+  buffer.Resize(0);
+  buffer.ResizeForOverwrite(4096);
+  CHECK(buffer.Capacity() == capacity);
+  for (size_t i = 0; i < buffer.Size(); ++i) {
+    CHECK(buffer[i] == 0xAB);
+  }
+  buffer.Resize(0);
+  buffer.Resize(4096);
+  for (size_t i = 0; i < buffer.Size(); ++i) {
+    CHECK(buffer[i] == 0);
+  }
+
+  // The intended use: size the buffer, then fill it.
+  const char text[] = "filled after resizing";
+  Vector<char> bytes(3, 'x');
+  bytes.ResizeForOverwrite(3 + sizeof(text));
+  std::memcpy(bytes.Data() + 3, text, sizeof(text));
+  CHECK(bytes[0] == 'x' && bytes[2] == 'x');
+  CHECK(std::strcmp(bytes.Data() + 3, text) == 0);
+}
+
+int defaults = 0;
+int constructed = 0;
+int destroyed = 0;
+int throw_at = -1;
+
+struct Counted {
+  int value;
+  Counted() : value(42) {
+    if (defaults == throw_at) {
+      throw std::runtime_error("construct");
+    }
+    ++defaults;
+    ++constructed;
+  }
+  Counted(const Counted& other) : value(other.value) {
+    ++constructed;
+  }
+  ~Counted() {
+    ++destroyed;
+  }
+};
+
+// Types with a default constructor still get it called for every new element.
+void TestNonTrivialElementsConstructed() {
+  {
+    Vector<Counted> vector;
+    vector.ResizeDefaultInit(10);
+    CHECK(defaults == 10);
+    CHECK(vector[9].value == 42);
+    vector.ResizeForOverwrite(4);
+    CHECK(destroyed == 6);
+    CHECK(vector.Size() == 4);
+
+    throw_at = defaults + 3;
+    bool thrown = false;
+    try {
+      vector.ResizeDefaultInit(20);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    throw_at = -1;
+    CHECK(thrown);
+    CHECK(vector.Size() == 4);
+    CHECK(constructed - destroyed == 4);
+  }
+  CHECK(constructed == destroyed);
+
+  Vector<std::string> strings(2, "kept");
+  strings.ResizeForOverwrite(5);
+  CHECK(strings[1] == "kept" && strings[2].empty() && strings[4].empty());
+}
+}  // namespace
+
+int main() {
+  TestTrivialElementsUntouched();
+  TestNonTrivialElementsConstructed();
+  return 0;
+}
@@ -0,0 +1,63 @@
+#include <sstream>
+#include <string>
+
+#include "../vector.h"
+#include "../vector_telemetry_report.h"
+#include "test.h"
+
+namespace {
+struct Tracked {
+  int value = 0;
+};
+}  // namespace
+
+template <>
+struct VectorTelemetryEnabled<Tracked> : std::true_type {};
+
+namespace {
+size_t RecordCount() {
+  size_t count = 0;
+  for (auto record = VectorTelemetry::First(); record != nullptr; record = record->next) {
+    ++count;
+  }
+  return count;
+}
+
+void TestCounters() {
+  Vector<Tracked> vector;
+  for (int i = 0; i < 100; ++i) {
+    vector.PushBack(Tracked{i});
+  }
+  auto& record = VectorTelemetry::Record<Tracked>();
+  CHECK(record.allocations > 0);
+  CHECK(record.reallocations.load() + 1 == record.allocations.load());
+  CHECK(record.peak_capacity == vector.Capacity());
+  CHECK(record.bytes_moved > 0 && record.bytes_moved % sizeof(Tracked) == 0);
+
+  Vector<Tracked> copy = vector;
+  CHECK(record.elements_copied == 100);
+
+  VectorTelemetry::Reset();
+  CHECK(record.allocations == 0 && record.elements_copied == 0 && record.peak_capacity == 0);
+}
+
+// Types that are not opted in never register a record.
+void TestDisabledTypes() {
+  Vector<int> ints(1000, 1);
+  ints.PushBack(2);
+  Vector<std::string> strings(10, "x");
+  Vector<std::string> copy = strings;
+  CHECK(RecordCount() == 1);
+
+  std::ostringstream report;
+  VectorTelemetryDump(report);
+  CHECK(report.str().find("Tracked: allocations=0") != std::string::npos);
+  CHECK(report.str().find("int") == std::string::npos);
+}
+}  // namespace
+
+int main() {
+  TestCounters();
+  TestDisabledTypes();
+  return 0;
+}
@@ -1,6 +1,8 @@
 #ifndef UNIQUE_PTR_
 #define UNIQUE_PTR_
 
+#include <type_traits>
+
 template <class T>
 class UniquePtr {
 
@@ -8,6 +10,7 @@ class UniquePtr {
   T* unique_ptr_;
 
  public:
+  using TriviallyRelocatable = std::true_type;
   UniquePtr() : unique_ptr_(nullptr) {
   }
 
@@ -2,40 +2,140 @@
 #define VECTOR_H_
 #define VECTOR_MEMORY_IMPLEMENTED
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iterator>
 #include <type_traits>
 #include <initializer_list>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 
+#include "hash.h"
+#include "vector_telemetry.h"
+
 class VectorOutOfRange : public std::out_of_range {
  public:
   VectorOutOfRange() : std::out_of_range("VectorOutOfRange") {
   }
 };
 
-template <typename T>
+template <class T, class = void>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+// Types opt in with a public `using TriviallyRelocatable = std::true_type;`
+template <class T>
+struct IsTriviallyRelocatable<T, std::void_t<typename T::TriviallyRelocatable>> : T::TriviallyRelocatable {};
+
+template <class T>
+inline constexpr bool kIsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+template <class Alloc, class = void>
+struct HasReallocate : std::false_type {};
+
+template <class Alloc>
+struct HasReallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(nullptr, 0, 0))>>
+    : std::true_type {};
+
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kHugePageSize = size_t(1) << 21;
+
+// Growth policies provide NextCapacity, which picks the capacity for an append that needs `required`
+// slots, and OnReallocate, which is told about every buffer Vector replaces.
+template <size_t Numerator = 2, size_t Denominator = 1, size_t HugePageThreshold = kHugePageSize>
+struct GeometricGrowth {
+  static_assert(Numerator > Denominator, "growth factor must be greater than one");
+
+  static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) {
+    size_t new_cap = 0;
+    if (capacity == 0) {
+      new_cap = std::max<size_t>(1, kCacheLineSize / element_size);
+    } else if (capacity <= SIZE_MAX / Numerator) {
+      new_cap = std::max(capacity + 1, capacity * Numerator / Denominator);
+    }
+    new_cap = std::max(new_cap, required);
+    // Rounding is skipped where it would overflow; the allocation fails on its own there.
+    if (HugePageThreshold != 0 && new_cap <= (SIZE_MAX - kHugePageSize) / element_size &&
+        new_cap * element_size >= HugePageThreshold) {
+      size_t bytes = (new_cap * element_size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+      new_cap = bytes / element_size;
+    }
+    return new_cap;
+  }
+
+  static void OnReallocate(size_t, size_t, size_t) noexcept {
+  }
+};
+
+struct GrowthCounters {
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> reallocations{0};
+  std::atomic<size_t> bytes_copied{0};
+  std::atomic<size_t> peak_capacity{0};
+};
+
+// Wraps a policy and accumulates its events into counters shared by every Vector using the same Tag.
+template <class Policy = GeometricGrowth<>, class Tag = void>
+struct CountedGrowth {
+  static GrowthCounters& Counters() {
+    static GrowthCounters counters;
+    return counters;
+  }
+
+  static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) {
+    return Policy::NextCapacity(capacity, required, element_size);
+  }
+
+  static void OnReallocate(size_t old_capacity, size_t new_capacity, size_t bytes_copied) noexcept {
+    auto& counters = Counters();
+    if (old_capacity == 0) {
+      counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      counters.reallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    counters.bytes_copied.fetch_add(bytes_copied, std::memory_order_relaxed);
+    size_t peak = counters.peak_capacity.load(std::memory_order_relaxed);
+    while (peak < new_capacity &&
+           !counters.peak_capacity.compare_exchange_weak(peak, new_capacity, std::memory_order_relaxed)) {
+    }
+    Policy::OnReallocate(old_capacity, new_capacity, bytes_copied);
+  }
+};
+
+template <typename T, class Alloc = std::allocator<T>, class Growth = GeometricGrowth<>>
 class Vector {
  private:
+  using AllocTraits = std::allocator_traits<Alloc>;
   T* vector_;
   size_t size_;
   size_t capacity_;
-  template <typename U = T>
-  void PushBackHelperMove(size_t, U&&);
+  Alloc alloc_;
+  T* Allocate(size_t);
+  void Deallocate(T*, size_t) noexcept;
+  static constexpr bool kUseReallocate = kIsTriviallyRelocatableV<T> && HasReallocate<Alloc>::value;
+  void Reallocate(size_t);
+  void NotifyReallocate(size_t) noexcept;
+  size_t GrowCapacity(size_t) const;
   template <typename... Args>
   void EmplaceBackHelper(size_t, Args&&...);
 
  public:
-  Vector() noexcept : vector_(nullptr), size_(0), capacity_(0) {
+  Vector() noexcept(noexcept(Alloc())) : vector_(nullptr), size_(0), capacity_(0), alloc_() {
   }
-  explicit Vector(size_t);
-  Vector(size_t, const T&);
+  explicit Vector(const Alloc& alloc) noexcept : vector_(nullptr), size_(0), capacity_(0), alloc_(alloc) {
+  }
+  explicit Vector(size_t, const Alloc& = Alloc());
+  Vector(size_t, const T&, const Alloc& = Alloc());
   template <class It, class = std::enable_if_t<std::is_base_of<
-                          std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>>
-  Vector(It, It);
-  Vector(std::initializer_list<T>);  // NOLINT
-  Vector(const Vector&);             // NOLINT
-  Vector(Vector&&) noexcept;         // NOLINT
+                          std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>>
+  Vector(It, It, const Alloc& = Alloc());
+  Vector(std::initializer_list<T>, const Alloc& = Alloc());  // NOLINT
+  Vector(const Vector&);                                     // NOLINT
+  Vector(const Vector&, const Alloc&);
+  Vector(Vector&&) noexcept;  // NOLINT
   Vector& operator=(const Vector& other);
   Vector& operator=(Vector&& other) noexcept;
   size_t Size() const noexcept;
@@ -52,8 +152,13 @@ class Vector {
   T* Data() noexcept;
   const T* Data() const noexcept;
   void Swap(Vector&) noexcept;
+  Alloc GetAllocator() const;
   void Resize(size_t);
   void Resize(size_t, const T&);
+  void ResizeDefaultInit(size_t);
+  void ResizeForOverwrite(size_t);
+  template <class ConstructRange>
+  void AppendConstructed(size_t, ConstructRange);
   void Reserve(const size_t);
   void ShrinkToFit();
   void Clear();
@@ -75,6 +180,19 @@ class Vector {
   using ConstPointer = const T*;
   using ValueType = T;
   using SizeType = size_t;
+  using TriviallyRelocatable =
+      std::bool_constant<std::is_empty_v<Alloc> || IsTriviallyRelocatable<Alloc>::value>;
+
+  template <class It, class = std::enable_if_t<std::is_base_of<
+                          std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>>
+  void Append(It, It);
+  template <class It, class = std::enable_if_t<std::is_base_of<
+                          std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>>
+  Iterator Insert(ConstIterator, It, It);
+  Iterator Erase(ConstIterator);
+  Iterator Erase(ConstIterator, ConstIterator);
+  template <class Predicate>
+  size_t EraseIf(Predicate);
 
   Iterator begin();  // NOLINT
 
@@ -93,68 +211,75 @@ class Vector {
   ConstReverseIterator crend() const;    // NOLINT
 };
 
-template <typename T>
-typename Vector<T>::Iterator Vector<T>::begin() {  // NOLINT
-  return Vector<T>::Iterator(vector_);
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::Iterator Vector<T, Alloc, Growth>::begin() {  // NOLINT
+  return Vector<T, Alloc, Growth>::Iterator(vector_);
 }
 
-template <typename T>
-typename Vector<T>::ConstIterator Vector<T>::begin() const {  // NOLINT
-  return Vector<T>::ConstIterator(vector_);
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ConstIterator Vector<T, Alloc, Growth>::begin() const {  // NOLINT
+  return Vector<T, Alloc, Growth>::ConstIterator(vector_);
 }
 
-template <typename T>
-typename Vector<T>::Iterator Vector<T>::end() {  // NOLINT
-  return Vector<T>::Iterator(vector_ + size_);
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::Iterator Vector<T, Alloc, Growth>::end() {  // NOLINT
+  return Vector<T, Alloc, Growth>::Iterator(vector_ + size_);
 }
 
-template <typename T>
-typename Vector<T>::ConstIterator Vector<T>::end() const {  // NOLINT
-  return Vector<T>::ConstIterator(vector_ + size_);
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ConstIterator Vector<T, Alloc, Growth>::end() const {  // NOLINT
+  return Vector<T, Alloc, Growth>::ConstIterator(vector_ + size_);
 }
 
-template <typename T>
-typename Vector<T>::ConstIterator Vector<T>::cbegin() const {  // NOLINT
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ConstIterator Vector<T, Alloc, Growth>::cbegin() const {  // NOLINT
   return begin();
 }
 
-template <typename T>
-typename Vector<T>::ConstIterator Vector<T>::cend() const {  // NOLINT
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ConstIterator Vector<T, Alloc, Growth>::cend() const {  // NOLINT
   return end();
 }
 
-template <typename T>
-typename Vector<T>::ReverseIterator Vector<T>::rbegin() {  // NOLINT
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ReverseIterator Vector<T, Alloc, Growth>::rbegin() {  // NOLINT
   return std::make_reverse_iterator(end());
 }
 
-template <typename T>
-typename Vector<T>::ConstReverseIterator Vector<T>::rbegin() const {  // NOLINT
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ConstReverseIterator Vector<T, Alloc, Growth>::rbegin() const {  // NOLINT
   return std::make_reverse_iterator(end());
 }
 
-template <typename T>
-typename Vector<T>::ReverseIterator Vector<T>::rend() {  // NOLINT
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ReverseIterator Vector<T, Alloc, Growth>::rend() {  // NOLINT
   return std::make_reverse_iterator(begin());
 }
 
-template <typename T>
-typename Vector<T>::ConstReverseIterator Vector<T>::rend() const {  // NOLINT
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ConstReverseIterator Vector<T, Alloc, Growth>::rend() const {  // NOLINT
   return std::make_reverse_iterator(begin());
 }
 
-template <typename T>
-typename Vector<T>::ConstReverseIterator Vector<T>::crbegin() const {  // NOLINT
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ConstReverseIterator Vector<T, Alloc, Growth>::crbegin() const {  // NOLINT
   return rbegin();
 }
 
-template <typename T>
-typename Vector<T>::ConstReverseIterator Vector<T>::crend() const {  // NOLINT
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::ConstReverseIterator Vector<T, Alloc, Growth>::crend() const {  // NOLINT
   return rend();
 }
 
 template <typename T>
 void TransferArray(T* vector1, T* vector2, size_t size) {
+  VectorTelemetryOnCopy<T>(size);
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (size != 0) {
+      std::memcpy(static_cast<void*>(vector1), static_cast<const void*>(vector2), size * sizeof(T));
+    }
+    return;
+  }
   size_t index = 0;
   try {
     for (; index < size; ++index) {
@@ -170,47 +295,108 @@ void TransferArray(T* vector1, T* vector2, size_t size) {
 
 template <typename T>
 void TransferArrayMove(T* vector1, T* vector2, size_t size) {
+  VectorTelemetryOnMove<T>(size);
   size_t index = 0;
   try {
     for (; index < size; ++index) {
       new (vector1 + index) T(std::move_if_noexcept(vector2[index]));
     }
   } catch (...) {
-    for (; index < size; ++index) {
-      vector1[index].~T();
+    for (size_t i = 0; i < index; ++i) {
+      vector1[i].~T();
     }
+    throw;
   }
 }
 
 template <typename T>
-void Vector<T>::Reserve(size_t new_cap) {
-  if (capacity_ < new_cap) {
-    auto vector_temp = reinterpret_cast<T*>(operator new(new_cap * sizeof(T)));
-    try {
-      TransferArrayMove(vector_temp, vector_, size_);
-    } catch (...) {
-      operator delete(vector_temp);
-      throw;
+void RelocateArray(T* vector1, T* vector2, size_t size) {
+  if constexpr (kIsTriviallyRelocatableV<T>) {
+    VectorTelemetryOnMove<T>(size);
+    if (size != 0) {
+      std::memcpy(static_cast<void*>(vector1), static_cast<const void*>(vector2), size * sizeof(T));
     }
-    if (!noexcept(T(std::move(vector_temp[0])))) {
-      for (size_t i = 0; i < size_; ++i) {
-        vector_[i].~T();
-      }
+  } else {
+    TransferArrayMove(vector1, vector2, size);
+    for (size_t i = 0; i < size; ++i) {
+      vector2[i].~T();
     }
-    operator delete(vector_);
-    capacity_ = new_cap;
-    vector_ = vector_temp;
   }
 }
 
-template <typename T>
-Vector<T>::Vector(const Vector& other) {
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::Reallocate(size_t new_cap) {
+  NotifyReallocate(new_cap);
+  if (new_cap == 0) {
+    Deallocate(vector_, capacity_);
+    vector_ = nullptr;
+    capacity_ = 0;
+    return;
+  }
+  if constexpr (kUseReallocate) {
+    if (vector_ != nullptr) {
+      VectorTelemetryOnMove<T>(size_);
+      vector_ = alloc_.reallocate(vector_, capacity_, new_cap);
+      capacity_ = new_cap;
+      return;
+    }
+  }
+  auto vector_temp = Allocate(new_cap);
+  try {
+    RelocateArray(vector_temp, vector_, size_);
+  } catch (...) {
+    Deallocate(vector_temp, new_cap);
+    throw;
+  }
+  Deallocate(vector_, capacity_);
+  vector_ = vector_temp;
+  capacity_ = new_cap;
+}
+
+template <typename T, class Alloc, class Growth>
+size_t Vector<T, Alloc, Growth>::GrowCapacity(size_t new_size) const {
+  return Growth::NextCapacity(capacity_, new_size, sizeof(T));
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::Reserve(size_t new_cap) {
+  if (capacity_ < new_cap) {
+    Reallocate(new_cap);
+  }
+}
+
+template <typename T, class Alloc, class Growth>
+T* Vector<T, Alloc, Growth>::Allocate(size_t count) {
+  VectorTelemetryOnAllocate<T>(count);
+  return AllocTraits::allocate(alloc_, count);
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::NotifyReallocate(size_t new_cap) noexcept {
+  Growth::OnReallocate(capacity_, new_cap, size_ * sizeof(T));
+  VectorTelemetryOnReallocate<T>(capacity_, new_cap);
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::Deallocate(T* ptr, size_t count) noexcept {
+  if (ptr != nullptr) {
+    AllocTraits::deallocate(alloc_, ptr, count);
+  }
+}
+
+template <typename T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(const Vector& other)
+    : Vector(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+}
+
+template <typename T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(const Vector& other, const Alloc& alloc) : alloc_(alloc) {
   if (other.capacity_ != 0) {
-    vector_ = reinterpret_cast<T*>(operator new(other.capacity_ * sizeof(T)));
+    vector_ = Allocate(other.capacity_);
     try {
       TransferArray(vector_, other.vector_, other.size_);
     } catch (...) {
-      operator delete(vector_);
+      Deallocate(vector_, other.capacity_);
       throw;
     }
   } else {
@@ -220,44 +406,64 @@ Vector<T>::Vector(const Vector& other) {
   capacity_ = other.capacity_;
 }
 
-template <typename T>
-Vector<T>::Vector(Vector&& other) noexcept : vector_(other.vector_), size_(other.size_), capacity_(other.capacity_) {
+template <typename T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(Vector&& other) noexcept
+    : vector_(other.vector_), size_(other.size_), capacity_(other.capacity_), alloc_(std::move(other.alloc_)) {
   other.vector_ = nullptr;
   other.size_ = 0;
   other.capacity_ = 0;
 }
 
-template <typename T>
+template <typename T, class Alloc, class Growth>
 template <class It, class>
-Vector<T>::Vector(It it_begin, It it_end) {
-  size_t size = 0;
-  for (auto it = it_begin; it != it_end; ++it) {
-    ++size;
-  }
-  if (size != 0) {
-    size_t index = 0;
-    vector_ = reinterpret_cast<T*>(operator new(size * sizeof(T)));
+Vector<T, Alloc, Growth>::Vector(It it_begin, It it_end, const Alloc& alloc)
+    : vector_(nullptr), size_(0), capacity_(0), alloc_(alloc) {
+  using Category = typename std::iterator_traits<It>::iterator_category;
+  if constexpr (!std::is_base_of_v<std::forward_iterator_tag, Category>) {
+    // Single pass: the range can only be read once, so grow geometrically while reading.
     try {
-      for (auto it = it_begin; index < size; ++index, ++it) {
-        new (vector_ + index) T(*it);
+      for (auto it = it_begin; it != it_end; ++it) {
+        EmplaceBack(*it);
       }
     } catch (...) {
-      for (size_t i = 0; i < index; ++i) {
-        vector_[i].~T();
-      }
-      operator delete(vector_);
+      Clear();
+      Deallocate(vector_, capacity_);
       throw;
     }
   } else {
-    vector_ = nullptr;
+    size_t size = 0;
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag, Category>) {
+      size = it_end - it_begin;
+    } else {
+      for (auto it = it_begin; it != it_end; ++it) {
+        ++size;
+      }
+    }
+    if (size != 0) {
+      size_t index = 0;
+      vector_ = Allocate(size);
+      try {
+        for (auto it = it_begin; index < size; ++index, ++it) {
+          new (vector_ + index) T(*it);
+        }
+      } catch (...) {
+        for (size_t i = 0; i < index; ++i) {
+          vector_[i].~T();
+        }
+        Deallocate(vector_, size);
+        throw;
+      }
+    } else {
+      vector_ = nullptr;
+    }
+    capacity_ = size_ = size;
   }
-  capacity_ = size_ = size;
 }
 
-template <typename T>
-Vector<T>::Vector(size_t size) {
+template <typename T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(size_t size, const Alloc& alloc) : alloc_(alloc) {
   if (size != 0) {
-    vector_ = reinterpret_cast<T*>(operator new(size * sizeof(T)));
+    vector_ = Allocate(size);
     size_t index = 0;
     try {
       for (; index < size; ++index) {
@@ -267,7 +473,7 @@ Vector<T>::Vector(size_t size) {
       for (size_t i = 0; i < index; ++i) {
         vector_[i].~T();
       }
-      operator delete(vector_);
+      Deallocate(vector_, size);
       throw;
     }
   } else {
@@ -276,10 +482,10 @@ Vector<T>::Vector(size_t size) {
   capacity_ = size_ = size;
 }
 
-template <typename T>
-Vector<T>::Vector(size_t size, const T& value) {
+template <typename T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(size_t size, const T& value, const Alloc& alloc) : alloc_(alloc) {
   if (size != 0) {
-    vector_ = reinterpret_cast<T*>(operator new(size * sizeof(T)));
+    vector_ = Allocate(size);
     size_t index = 0;
     try {
       for (; index < size; ++index) {
@@ -289,7 +495,7 @@ Vector<T>::Vector(size_t size, const T& value) {
       for (size_t i = 0; i < index; ++i) {
         vector_[i].~T();
       }
-      operator delete(vector_);
+      Deallocate(vector_, size);
       throw;
     }
   } else {
@@ -298,122 +504,191 @@ Vector<T>::Vector(size_t size, const T& value) {
   capacity_ = size_ = size;
 }
 
-template <typename T>
-Vector<T>::Vector(std::initializer_list<T> list) : Vector(list.begin(), list.end()) {
+template <typename T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(std::initializer_list<T> list, const Alloc& alloc) : Vector(list.begin(), list.end(), alloc) {
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(const Vector<T>& other) {
+template <typename T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(const Vector<T, Alloc, Growth>& other) {
   try {
-    Vector<T> copy(other);
+    Vector<T, Alloc, Growth> copy(other, alloc_);
     Swap(copy);
   } catch (...) {
-    Vector<T> copy = std::move(Vector());
+    Vector<T, Alloc, Growth> copy(alloc_);
     Swap(copy);
     throw;
   }
   return *this;
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(Vector<T>&& other) noexcept {
+template <typename T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(Vector<T, Alloc, Growth>&& other) noexcept {
   auto copy(std::move(other));
   Swap(copy);
   return *this;
 }
 
-template <typename T>
-size_t Vector<T>::Size() const noexcept {
+template <typename T, class Alloc, class Growth>
+size_t Vector<T, Alloc, Growth>::Size() const noexcept {
   return size_;
 }
 
-template <typename T>
-size_t Vector<T>::Capacity() const noexcept {
+template <typename T, class Alloc, class Growth>
+size_t Vector<T, Alloc, Growth>::Capacity() const noexcept {
   return capacity_;
 }
 
-template <typename T>
-bool Vector<T>::Empty() const noexcept {
+template <typename T, class Alloc, class Growth>
+bool Vector<T, Alloc, Growth>::Empty() const noexcept {
   return (size_ == 0);
 }
 
-template <typename T>
-T& Vector<T>::operator[](size_t index) {
+template <typename T, class Alloc, class Growth>
+T& Vector<T, Alloc, Growth>::operator[](size_t index) {
   return *(vector_ + index);
 }
 
-template <typename T>
-const T& Vector<T>::operator[](size_t index) const {
+template <typename T, class Alloc, class Growth>
+const T& Vector<T, Alloc, Growth>::operator[](size_t index) const {
   return *(vector_ + index);
 }
 
-template <typename T>
-const T& Vector<T>::At(size_t index) const {
+template <typename T, class Alloc, class Growth>
+const T& Vector<T, Alloc, Growth>::At(size_t index) const {
   if (index >= size_) {
     throw VectorOutOfRange{};
   }
   return *(vector_ + index);
 }
 
-template <typename T>
-T& Vector<T>::At(size_t index) {
+template <typename T, class Alloc, class Growth>
+T& Vector<T, Alloc, Growth>::At(size_t index) {
   if (index >= size_) {
     throw VectorOutOfRange{};
   }
   return *(vector_ + index);
 }
 
-template <typename T>
-T& Vector<T>::Front() noexcept {
+template <typename T, class Alloc, class Growth>
+T& Vector<T, Alloc, Growth>::Front() noexcept {
   return *vector_;
 }
 
-template <typename T>
-const T& Vector<T>::Front() const noexcept {
+template <typename T, class Alloc, class Growth>
+const T& Vector<T, Alloc, Growth>::Front() const noexcept {
   return *vector_;
 }
 
-template <typename T>
-T& Vector<T>::Back() noexcept {
+template <typename T, class Alloc, class Growth>
+T& Vector<T, Alloc, Growth>::Back() noexcept {
   return vector_[Size() - 1];
 }
 
-template <typename T>
-const T& Vector<T>::Back() const noexcept {
+template <typename T, class Alloc, class Growth>
+const T& Vector<T, Alloc, Growth>::Back() const noexcept {
   return vector_[Size() - 1];
 }
 
-template <typename T>
-T* Vector<T>::Data() noexcept {
+template <typename T, class Alloc, class Growth>
+T* Vector<T, Alloc, Growth>::Data() noexcept {
   return vector_;
 }
 
-template <typename T>
-const T* Vector<T>::Data() const noexcept {
+template <typename T, class Alloc, class Growth>
+const T* Vector<T, Alloc, Growth>::Data() const noexcept {
   return vector_;
 }
 
-template <typename T>
-void Vector<T>::Swap(Vector& other) noexcept {
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::Swap(Vector& other) noexcept {
   std::swap(vector_, other.vector_);
   std::swap(size_, other.size_);
   std::swap(capacity_, other.capacity_);
+  std::swap(alloc_, other.alloc_);
 }
 
-template <typename T>
-void Vector<T>::Resize(size_t new_size) {
-  if (capacity_ >= new_size) {
-    if (size_ >= new_size) {
-      for (size_t i = new_size; i < size_; ++i) {
-        vector_[i].~T();
-      }
-      size_ = new_size;
-      return;
+template <typename T, class Alloc, class Growth>
+Alloc Vector<T, Alloc, Growth>::GetAllocator() const {
+  return alloc_;
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::Resize(size_t new_size) {
+  if (size_ >= new_size) {
+    for (size_t i = new_size; i < size_; ++i) {
+      vector_[i].~T();
+    }
+    size_ = new_size;
+    return;
+  }
+  if (capacity_ < new_size) {
+    Reallocate(GrowCapacity(new_size));
+  }
+  size_t index = size_;
+  try {
+    for (; index < new_size; ++index) {
+      new (vector_ + index) T();
+    }
+  } catch (...) {
+    for (size_t i = size_; i < index; ++i) {
+      vector_[i].~T();
     }
+    throw;
+  }
+  size_ = new_size;
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::Resize(size_t new_size, const T& value) {
+  if (size_ >= new_size) {
+    for (size_t i = new_size; i < size_; ++i) {
+      vector_[i].~T();
+    }
+    size_ = new_size;
+    return;
+  }
+  const T* source = &value;
+  if (capacity_ < new_size) {
+    std::less<const T*> less;
+    bool is_inside = !less(source, vector_) && less(source, vector_ + size_);
+    size_t offset = (is_inside ? source - vector_ : 0);
+    Reallocate(GrowCapacity(new_size));
+    if (is_inside) {
+      source = vector_ + offset;
+    }
+  }
+  size_t index = size_;
+  try {
+    for (; index < new_size; ++index) {
+      new (vector_ + index) T(*source);
+    }
+  } catch (...) {
+    for (size_t i = size_; i < index; ++i) {
+      vector_[i].~T();
+    }
+    throw;
+  }
+  size_ = new_size;
+}
+
+// New elements are default-initialized, so trivial types are left uninitialized instead of zeroed.
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::ResizeDefaultInit(size_t new_size) {
+  if (size_ >= new_size) {
+    for (size_t i = new_size; i < size_; ++i) {
+      vector_[i].~T();
+    }
+    size_ = new_size;
+    return;
+  }
+  if (capacity_ < new_size) {
+    Reallocate(GrowCapacity(new_size));
+  }
+  if constexpr (!std::is_trivially_default_constructible_v<T>) {
     size_t index = size_;
     try {
       for (; index < new_size; ++index) {
-        new (vector_ + index) T();
+        new (vector_ + index) T;
       }
     } catch (...) {
       for (size_t i = size_; i < index; ++i) {
@@ -421,64 +696,121 @@ void Vector<T>::Resize(size_t new_size) {
       }
       throw;
     }
-    size_ = new_size;
+  }
+  size_ = new_size;
+}
+
+// For buffers that are filled right after resizing, e.g. Data() passed to read().
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::ResizeForOverwrite(size_t new_size) {
+  ResizeDefaultInit(new_size);
+}
+
+// construct_range(ptr, count) must construct ptr[0, count) or destroy what it built and throw.
+template <typename T, class Alloc, class Growth>
+template <class ConstructRange>
+void Vector<T, Alloc, Growth>::AppendConstructed(size_t count, ConstructRange construct_range) {
+  if (count == 0) {
     return;
   }
-  size_t new_cap = (!Capacity() ? 1 : capacity_);
-  while (new_size > new_cap) {
-    new_cap *= 2;
+  if (capacity_ - size_ < count) {
+    Reallocate(GrowCapacity(size_ + count));
   }
-  auto vector_temp = reinterpret_cast<T*>(operator new(new_cap * sizeof(T)));
-  if (size_ < new_size) {
-    size_t index = size_;
+  construct_range(vector_ + size_, count);
+  size_ += count;
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::ShrinkToFit() {
+  if (capacity_ != size_) {
+    Reallocate(size_);
+  }
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::Clear() {
+  for (size_t i = 0; i < size_; ++i) {
+    vector_[i].~T();
+  }
+  size_ = 0;
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::PushBack(const T& value) {
+  EmplaceBack(value);
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::PushBack(T&& value) {
+  EmplaceBack(std::move(value));
+}
+
+template <typename T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::PopBack() {
+  vector_[size_ - 1].~T();
+  --size_;
+}
+
+template <typename T, class Alloc, class Growth>
+template <typename... Args>
+void Vector<T, Alloc, Growth>::EmplaceBackHelper(size_t new_cap, Args&&... args) {
+  if constexpr (kUseReallocate) {
+    // args may refer to an element of the buffer that reallocate is about to move.
+    alignas(T) unsigned char slot[sizeof(T)];
+    auto value = new (slot) T(std::forward<Args>(args)...);
     try {
-      for (; index < new_size; ++index) {
-        new (vector_temp + index) T();
-      }
+      Reallocate(new_cap);
     } catch (...) {
-      for (size_t i = size_; i < index; ++i) {
-        vector_temp[i].~T();
-      }
-      operator delete(vector_temp);
+      value->~T();
       throw;
     }
+    std::memcpy(static_cast<void*>(vector_ + size_), slot, sizeof(T));
+  } else {
+    NotifyReallocate(new_cap);
+    auto vector_temp = Allocate(new_cap);
     try {
-      TransferArrayMove(vector_temp, vector_, size_);
+      new (vector_temp + size_) T(std::forward<Args>(args)...);
     } catch (...) {
-      for (size_t i = size_; i < index; ++i) {
-        vector_temp[i].~T();
-      }
-      operator delete(vector_temp);
+      Deallocate(vector_temp, new_cap);
       throw;
     }
-    if (!noexcept(T(std::move(vector_temp[0])))) {
-      for (size_t i = 0; i < size_; ++i) {
-        vector_[i].~T();
-      }
-    }
-    if (capacity_) {
-      operator delete(vector_);
+    try {
+      RelocateArray(vector_temp, vector_, size_);
+    } catch (...) {
+      vector_temp[size_].~T();
+      Deallocate(vector_temp, new_cap);
+      throw;
     }
-    size_ = new_size;
+    Deallocate(vector_, capacity_);
     capacity_ = new_cap;
     vector_ = vector_temp;
   }
+  size_ += 1;
 }
 
-template <typename T>
-void Vector<T>::Resize(size_t new_size, const T& value) {
-  if (capacity_ >= new_size) {
-    if (size_ >= new_size) {
-      for (size_t i = new_size; i < size_; ++i) {
-        vector_[i].~T();
-      }
-      size_ = new_size;
-      return;
+template <typename T, class Alloc, class Growth>
+template <typename... Args>
+void Vector<T, Alloc, Growth>::EmplaceBack(Args&&... args) {
+  if (size_ == capacity_) {
+    EmplaceBackHelper(GrowCapacity(size_ + 1), std::forward<Args>(args)...);
+  } else {
+    new (vector_ + size_) T(std::forward<Args>(args)...);
+    size_ += 1;
+  }
+}
+
+template <typename T, class Alloc, class Growth>
+template <class It, class>
+void Vector<T, Alloc, Growth>::Append(It it_begin, It it_end) {
+  if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>) {
+    size_t count = std::distance(it_begin, it_end);
+    if (size_ + count > capacity_) {
+      Reallocate(GrowCapacity(size_ + count));
     }
     size_t index = size_;
     try {
-      for (; index < new_size; ++index) {
-        new (vector_ + index) T(value);
+      for (auto it = it_begin; it != it_end; ++it, ++index) {
+        new (vector_ + index) T(*it);
       }
     } catch (...) {
       for (size_t i = size_; i < index; ++i) {
@@ -486,268 +818,284 @@ void Vector<T>::Resize(size_t new_size, const T& value) {
       }
       throw;
     }
-    size_ = new_size;
-    return;
+    size_ = index;
+  } else {
+    for (auto it = it_begin; it != it_end; ++it) {
+      EmplaceBack(*it);
+    }
   }
-  size_t new_cap = (!Capacity() ? 1 : capacity_);
-  while (new_size > new_cap) {
-    new_cap *= 2;
+}
+
+template <typename T, class Alloc, class Growth>
+template <class It, class>
+typename Vector<T, Alloc, Growth>::Iterator Vector<T, Alloc, Growth>::Insert(ConstIterator pos, It it_begin,
+                                                                            It it_end) {
+  size_t offset = pos.vector_ - vector_;
+  size_t count = std::distance(it_begin, it_end);
+  size_t tail = size_ - offset;
+  if (count == 0) {
+    return Iterator(vector_ + offset);
   }
-  auto vector_temp = reinterpret_cast<T*>(operator new(new_cap * sizeof(T)));
-  if (size_ < new_size) {
-    size_t index = size_;
+  if (size_ + count > capacity_) {
+    size_t new_cap = GrowCapacity(size_ + count);
+    NotifyReallocate(new_cap);
+    auto vector_temp = Allocate(new_cap);
+    size_t index = offset;
     try {
-      for (; index < new_size; ++index) {
-        new (vector_temp + index) T(value);
+      for (auto it = it_begin; it != it_end; ++it, ++index) {
+        new (vector_temp + index) T(*it);
       }
     } catch (...) {
-      for (size_t i = size_; i < index; ++i) {
+      for (size_t i = offset; i < index; ++i) {
         vector_temp[i].~T();
       }
-      operator delete(vector_temp);
+      Deallocate(vector_temp, new_cap);
       throw;
     }
-    try {
-      TransferArrayMove(vector_temp, vector_, size_);
-    } catch (...) {
-      for (size_t i = size_; i < index; ++i) {
-        vector_temp[i].~T();
+    if constexpr (kIsTriviallyRelocatableV<T>) {
+      RelocateArray(vector_temp, vector_, offset);
+      RelocateArray(vector_temp + offset + count, vector_ + offset, tail);
+    } else {
+      try {
+        TransferArrayMove(vector_temp, vector_, offset);
+      } catch (...) {
+        for (size_t i = offset; i < offset + count; ++i) {
+          vector_temp[i].~T();
+        }
+        Deallocate(vector_temp, new_cap);
+        throw;
+      }
+      try {
+        TransferArrayMove(vector_temp + offset + count, vector_ + offset, tail);
+      } catch (...) {
+        for (size_t i = 0; i < offset + count; ++i) {
+          vector_temp[i].~T();
+        }
+        Deallocate(vector_temp, new_cap);
+        throw;
       }
-      operator delete(vector_temp);
-      throw;
-    }
-    if (!noexcept(T(std::move(vector_temp[0])))) {
       for (size_t i = 0; i < size_; ++i) {
         vector_[i].~T();
       }
     }
-    if (capacity_) {
-      operator delete(vector_);
-    }
-    size_ = new_size;
-    capacity_ = new_cap;
+    Deallocate(vector_, capacity_);
     vector_ = vector_temp;
+    capacity_ = new_cap;
+    size_ += count;
+    return Iterator(vector_ + offset);
   }
-}
-
-template <typename T>
-void Vector<T>::ShrinkToFit() {
-  if (capacity_ != size_) {
-    auto temp = (Empty() ? nullptr : reinterpret_cast<T*>(operator new(size_ * sizeof(T))));
+  T* position = vector_ + offset;
+  if constexpr (kIsTriviallyRelocatableV<T>) {
+    std::memmove(static_cast<void*>(position + count), static_cast<const void*>(position), tail * sizeof(T));
+    size_t index = 0;
     try {
-      TransferArrayMove(temp, vector_, size_);
+      for (auto it = it_begin; it != it_end; ++it, ++index) {
+        new (position + index) T(*it);
+      }
     } catch (...) {
-      operator delete(temp);
-      throw;
-    }
-    if (!noexcept(T(std::move(vector_[0])))) {
-      for (size_t i = 0; i < size_; ++i) {
-        vector_[i].~T();
+      for (size_t i = 0; i < index; ++i) {
+        position[i].~T();
       }
+      std::memmove(static_cast<void*>(position), static_cast<const void*>(position + count), tail * sizeof(T));
+      throw;
     }
-    if (vector_) {
-      operator delete(vector_);
-    }
-    vector_ = temp;
-    capacity_ = size_;
-  }
-}
-
-template <typename T>
-void Vector<T>::Clear() {
-  for (size_t i = 0; i < size_; ++i) {
-    vector_[i].~T();
-  }
-  size_ = 0;
-}
-
-template <typename T>
-void Vector<T>::PushBack(const T& value) {
-  if (capacity_ == 0) {
-    vector_ = reinterpret_cast<T*>(operator new(sizeof(T)));
-    capacity_ = 1;
-  }
-  if (size_ == capacity_) {
+    size_ += count;
+  } else if (tail > count) {
+    T* end = vector_ + size_;
+    std::uninitialized_move(end - count, end, end);
+    size_ += count;
+    std::move_backward(position, end - count, end);
+    std::copy(it_begin, it_end, position);
+  } else {
+    T* end = vector_ + size_;
+    auto middle = std::next(it_begin, tail);
+    std::uninitialized_copy(middle, it_end, end);
     try {
-      PushBackHelperMove(capacity_ * 2, value);
+      std::uninitialized_move(position, end, position + count);
     } catch (...) {
-      if (capacity_ == 1) {
-        operator delete(vector_);
-        capacity_ = 0;
-      }
+      std::destroy(end, end + (count - tail));
       throw;
     }
-  } else {
-    new (vector_ + size_) T(value);
-    size_ += 1;
+    size_ += count;
+    std::copy(it_begin, middle, position);
   }
+  return Iterator(position);
 }
 
-template <typename T>
-template <typename U>
-void Vector<T>::PushBackHelperMove(size_t new_cap, U&& value) {
-  auto vector_temp = reinterpret_cast<T*>(operator new(new_cap * sizeof(T)));
-  try {
-    TransferArrayMove(vector_temp, vector_, size_);
-  } catch (...) {
-    operator delete(vector_temp);
-    throw;
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::Iterator Vector<T, Alloc, Growth>::Erase(ConstIterator pos) {
+  return Erase(pos, pos + 1);
+}
+
+template <typename T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::Iterator Vector<T, Alloc, Growth>::Erase(ConstIterator first,
+                                                                           ConstIterator last) {
+  T* position = vector_ + (first.vector_ - vector_);
+  size_t count = last.vector_ - first.vector_;
+  size_t tail = (vector_ + size_) - (position + count);
+  if (count == 0) {
+    return Iterator(position);
   }
-  try {
-    new (vector_temp + size_) T(std::move_if_noexcept(std::forward<U>(value)));
-  } catch (...) {
-    for (size_t i = 0; i < size_; ++i) {
-      vector_temp[i].~T();
+  if constexpr (kIsTriviallyRelocatableV<T>) {
+    for (size_t i = 0; i < count; ++i) {
+      position[i].~T();
     }
-    operator delete(vector_temp);
-    throw;
-  }
-  if (!noexcept(T(std::move(vector_temp[0])))) {
-    for (size_t i = 0; i < size_; ++i) {
+    std::memmove(static_cast<void*>(position), static_cast<const void*>(position + count), tail * sizeof(T));
+  } else {
+    std::move(position + count, vector_ + size_, position);
+    for (size_t i = size_ - count; i < size_; ++i) {
       vector_[i].~T();
     }
   }
-  operator delete(vector_);
-  capacity_ = new_cap;
-  vector_ = vector_temp;
-  size_ += 1;
+  size_ -= count;
+  return Iterator(position);
 }
 
-template <typename T>
-void Vector<T>::PushBack(T&& value) {
-  if (capacity_ == 0) {
-    vector_ = reinterpret_cast<T*>(operator new(sizeof(T)));
-    capacity_ = 1;
-  }
-  if (size_ == capacity_) {
+template <typename T, class Alloc, class Growth>
+template <class Predicate>
+size_t Vector<T, Alloc, Growth>::EraseIf(Predicate predicate) {
+  size_t write = 0;
+  if constexpr (kIsTriviallyRelocatableV<T>) {
+    size_t read = 0;
     try {
-      PushBackHelperMove(capacity_ * 2, value);
-    } catch (...) {
-      if (capacity_ == 1) {
-        operator delete(vector_);
-        capacity_ = 0;
+      for (; read < size_; ++read) {
+        if (predicate(vector_[read])) {
+          vector_[read].~T();
+        } else {
+          if (write != read) {
+            std::memcpy(static_cast<void*>(vector_ + write), static_cast<const void*>(vector_ + read), sizeof(T));
+          }
+          ++write;
+        }
       }
+    } catch (...) {
+      std::memmove(static_cast<void*>(vector_ + write), static_cast<const void*>(vector_ + read),
+                   (size_ - read) * sizeof(T));
+      size_ = write + (size_ - read);
       throw;
     }
   } else {
-    new (vector_ + size_) T(std::move(value));
-    size_ += 1;
+    for (size_t read = 0; read < size_; ++read) {
+      if (!predicate(vector_[read])) {
+        if (write != read) {
+          vector_[write] = std::move(vector_[read]);
+        }
+        ++write;
+      }
+    }
+    for (size_t i = write; i < size_; ++i) {
+      vector_[i].~T();
+    }
   }
+  size_t erased = size_ - write;
+  size_ = write;
+  return erased;
 }
 
-template <typename T>
-void Vector<T>::PopBack() {
-  vector_[size_ - 1].~T();
-  --size_;
+template <typename T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::~Vector() {
+  Clear();
+  if (capacity_ != 0) {
+    Deallocate(vector_, capacity_);
+    capacity_ = 0;
+  }
 }
 
+// Types whose equality is equality of their bytes, so comparisons can run on memcmp.
+template <class T>
+inline constexpr bool kIsBitwiseComparableV = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+// Unsigned single bytes additionally order like memcmp.
+template <class T>
+inline constexpr bool kIsMemcmpOrderedV = std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) == 1;
+
+// Index of the first differing element; equal 64-byte blocks are skipped with memcmp.
 template <typename T>
-template <typename... Args>
-void Vector<T>::EmplaceBackHelper(size_t new_cap, Args&&... args) {
-  auto vector_temp = reinterpret_cast<T*>(operator new(new_cap * sizeof(T)));
-  try {
-    TransferArrayMove(vector_temp, vector_, size_);
-  } catch (...) {
-    operator delete(vector_temp);
-    throw;
-  }
-  try {
-    new (vector_temp + size_) T(std::forward<Args>(args)...);
-  } catch (...) {
-    for (size_t i = 0; i < size_ + 1; ++i) {
-      vector_temp[i].~T();
+size_t MismatchIndex(const T* array1, const T* array2, size_t size) {
+  size_t index = 0;
+  if constexpr (kIsBitwiseComparableV<T>) {
+    constexpr size_t kBlock = std::max<size_t>(1, kCacheLineSize / sizeof(T));
+    while (index + kBlock <= size && std::memcmp(array1 + index, array2 + index, kBlock * sizeof(T)) == 0) {
+      index += kBlock;
     }
-    operator delete(vector_temp);
-    throw;
   }
-  if (!noexcept(T(std::move(vector_temp[0])))) {
-    for (size_t i = 0; i < size_; ++i) {
-      vector_[i].~T();
-    }
+  while (index < size && !(array1[index] != array2[index])) {
+    ++index;
   }
-  operator delete(vector_);
-  capacity_ = new_cap;
-  vector_ = vector_temp;
-  size_ += 1;
+  return index;
 }
 
 template <typename T>
-template <typename... Args>
-void Vector<T>::EmplaceBack(Args&&... args) {
-  if (capacity_ == 0) {
-    vector_ = reinterpret_cast<T*>(operator new(sizeof(T)));
-    capacity_ = 1;
+bool ArraysEqual(const T* array1, size_t size1, const T* array2, size_t size2) {
+  if (size1 != size2) {
+    return false;
   }
-  if (size_ == capacity_) {
-    try {
-      EmplaceBackHelper(capacity_ * 2, std::forward<Args>(args)...);
-    } catch (...) {
-      if (capacity_ == 1) {
-        operator delete(vector_);
-        capacity_ = 0;
-      }
-    }
-  } else {
-    new (vector_ + size_) T(std::forward<Args>(args)...);
-    size_ += 1;
+  if constexpr (kIsBitwiseComparableV<T>) {
+    return size1 == 0 || std::memcmp(array1, array2, size1 * sizeof(T)) == 0;
   }
+  return MismatchIndex(array1, array2, size1) == size1;
 }
 
 template <typename T>
-Vector<T>::~Vector() {
-  Clear();
-  if (capacity_ != 0) {
-    operator delete(vector_);
-    capacity_ = 0;
+bool ArraysLess(const T* array1, size_t size1, const T* array2, size_t size2) {
+  size_t min_size = std::min(size1, size2);
+  if constexpr (kIsMemcmpOrderedV<T>) {
+    int result = (min_size == 0 ? 0 : std::memcmp(array1, array2, min_size));
+    return result < 0 || (result == 0 && size1 < size2);
   }
+  size_t index = MismatchIndex(array1, array2, min_size);
+  if (index < min_size) {
+    return array1[index] < array2[index];
+  }
+  return size1 < size2;
 }
 
-template <typename T>
-bool operator<(const Vector<T>& vector1, const Vector<T>& vector2) {
-  size_t min_size = std::min(vector1.Size(), vector2.Size());
-  for (size_t i = 0; i < min_size; ++i) {
-    if (vector1[i] != vector2[i]) {
-      return vector1[i] < vector2[i];
-    }
-  }
-  return vector1.Size() < vector2.Size();
+template <typename T, class Alloc, class Growth>
+bool operator<(const Vector<T, Alloc, Growth>& vector1, const Vector<T, Alloc, Growth>& vector2) {
+  return ArraysLess(vector1.Data(), vector1.Size(), vector2.Data(), vector2.Size());
 }
 
-template <typename T>
-bool operator>=(const Vector<T>& vector1, const Vector<T>& vector2) {
+template <typename T, class Alloc, class Growth>
+bool operator>=(const Vector<T, Alloc, Growth>& vector1, const Vector<T, Alloc, Growth>& vector2) {
   return !(vector1 < vector2);
 }
 
-template <typename T>
-bool operator==(const Vector<T>& vector1, const Vector<T>& vector2) {
-  return !(vector1 < vector2) && !(vector2 < vector1);
+template <typename T, class Alloc, class Growth>
+bool operator==(const Vector<T, Alloc, Growth>& vector1, const Vector<T, Alloc, Growth>& vector2) {
+  return ArraysEqual(vector1.Data(), vector1.Size(), vector2.Data(), vector2.Size());
 }
 
-template <typename T>
-bool operator<=(const Vector<T>& vector1, const Vector<T>& vector2) {
+template <typename T, class Alloc, class Growth>
+bool operator<=(const Vector<T, Alloc, Growth>& vector1, const Vector<T, Alloc, Growth>& vector2) {
   return !(vector1 > vector2);
 }
 
-template <typename T>
-bool operator>(const Vector<T>& vector1, const Vector<T>& vector2) {
+template <typename T, class Alloc, class Growth>
+bool operator>(const Vector<T, Alloc, Growth>& vector1, const Vector<T, Alloc, Growth>& vector2) {
   return vector2 < vector1;
 }
 
-template <typename T>
-bool operator!=(const Vector<T>& vector1, const Vector<T>& vector2) {
+template <typename T, class Alloc, class Growth>
+bool operator!=(const Vector<T, Alloc, Growth>& vector1, const Vector<T, Alloc, Growth>& vector2) {
   return !(vector1 == vector2);
 }
 
-template <typename T>
+template <typename T, class Alloc, class Growth>
 template <bool IsConst>
-class Vector<T>::common_iterator {  // NOLINT
+class Vector<T, Alloc, Growth>::common_iterator {  // NOLINT
  private:
   using Type = std::conditional_t<IsConst, const T, T>;
   Type* vector_;
+
+ public:
+  // Public so that other contiguous containers (SmallVector, views) can hand out the same iterators.
   explicit common_iterator(Type* ptr) : vector_(ptr) {
   }
 
- public:
+  template <bool IsConstOther, class = std::enable_if_t<IsConst && !IsConstOther>>
+  common_iterator(const common_iterator<IsConstOther>& it) : vector_(it.operator->()) {  // NOLINT
+  }
+
   using reference = Type&;                                    // NOLINT
   using pointer = Type*;                                      // NOLINT
   using iterator_category = std::random_access_iterator_tag;  // NOLINT
@@ -793,12 +1141,16 @@ class Vector<T>::common_iterator {  // NOLINT
   common_iterator& operator-=(int64_t n) {
     return *this += -n;
   }
+
+  common_iterator operator-(int64_t n) const {
+    return common_iterator(vector_ - n);
+  }
   Type& operator[](size_t index) const {
     return vector_[index];
   }
 
   template <bool IsConstNew>
-  int operator-(const common_iterator<IsConstNew>& it) const;
+  int64_t operator-(const common_iterator<IsConstNew>& it) const;
 
   template <bool IsConstNew>
   bool operator<(const common_iterator<IsConstNew>&) const;
@@ -819,10 +1171,10 @@ class Vector<T>::common_iterator {  // NOLINT
   bool operator!=(const common_iterator<IsConstNew>& it) const;
 };
 
-template <class T>
+template <class T, class Alloc, class Growth>
 template <bool IsConst>
 template <bool IsConstNew>
-int Vector<T>::common_iterator<IsConst>::operator-(const Vector<T>::common_iterator<IsConstNew>& it) const {
+int64_t Vector<T, Alloc, Growth>::common_iterator<IsConst>::operator-(const Vector<T, Alloc, Growth>::common_iterator<IsConstNew>& it) const {
   return (vector_ - it.vector_);
 }
 
@@ -837,58 +1189,69 @@ std::remove_const_t<CommonIterator> operator+(int n, const CommonIterator& it) {
   return it + n;
 }
 
-template <typename T, bool IsConst>
-typename Vector<T>::template common_iterator<IsConst> operator-(
-    const typename Vector<T>::template common_iterator<IsConst>& it, int n) {
-  return it + (-n);
-}
-
-template <typename T>
+template <typename T, class Alloc, class Growth>
 template <bool IsConst>
 template <bool IsConstNew>
-bool Vector<T>::common_iterator<IsConst>::operator<(
-    const typename Vector<T>::template common_iterator<IsConstNew>& it) const {
+bool Vector<T, Alloc, Growth>::common_iterator<IsConst>::operator<(
+    const typename Vector<T, Alloc, Growth>::template common_iterator<IsConstNew>& it) const {
   return ((*this - it) < 0);
 }
 
-template <typename T>
+template <typename T, class Alloc, class Growth>
 template <bool IsConst>
 template <bool IsConstNew>
-bool Vector<T>::common_iterator<IsConst>::operator==(
-    const typename Vector<T>::template common_iterator<IsConstNew>& it) const {
+bool Vector<T, Alloc, Growth>::common_iterator<IsConst>::operator==(
+    const typename Vector<T, Alloc, Growth>::template common_iterator<IsConstNew>& it) const {
   return ((*this - it) == 0);
 }
 
-template <typename T>
+template <typename T, class Alloc, class Growth>
 template <bool IsConst>
 template <bool IsConstNew>
-bool Vector<T>::common_iterator<IsConst>::operator>=(
-    const typename Vector<T>::template common_iterator<IsConstNew>& it) const {
+bool Vector<T, Alloc, Growth>::common_iterator<IsConst>::operator>=(
+    const typename Vector<T, Alloc, Growth>::template common_iterator<IsConstNew>& it) const {
   return !(*this < it);
 }
 
-template <typename T>
+template <typename T, class Alloc, class Growth>
 template <bool IsConst>
 template <bool IsConstNew>
-bool Vector<T>::common_iterator<IsConst>::operator>(
-    const typename Vector<T>::template common_iterator<IsConstNew>& it) const {
+bool Vector<T, Alloc, Growth>::common_iterator<IsConst>::operator>(
+    const typename Vector<T, Alloc, Growth>::template common_iterator<IsConstNew>& it) const {
   return (!(*this < it) && !(*this == it));
 }
 
-template <typename T>
+template <typename T, class Alloc, class Growth>
 template <bool IsConst>
 template <bool IsConstNew>
-bool Vector<T>::common_iterator<IsConst>::operator<=(
-    const typename Vector<T>::template common_iterator<IsConstNew>& it) const {
+bool Vector<T, Alloc, Growth>::common_iterator<IsConst>::operator<=(
+    const typename Vector<T, Alloc, Growth>::template common_iterator<IsConstNew>& it) const {
   return !(*this > it);
 }
 
-template <typename T>
+template <typename T, class Alloc, class Growth>
 template <bool IsConst>
 template <bool IsConstNew>
-bool Vector<T>::common_iterator<IsConst>::operator!=(
-    const typename Vector<T>::template common_iterator<IsConstNew>& it) const {
+bool Vector<T, Alloc, Growth>::common_iterator<IsConst>::operator!=(
+    const typename Vector<T, Alloc, Growth>::template common_iterator<IsConstNew>& it) const {
   return !(*this == it);
 }
 
+// Element types with unique object representations, such as the integers, are hashed as one byte
+// range; anything else folds the std::hash of each element.
+template <typename T, class Alloc, class Growth>
+struct std::hash<Vector<T, Alloc, Growth>> {
+  size_t operator()(const Vector<T, Alloc, Growth>& vector) const noexcept {
+    if constexpr (std::has_unique_object_representations_v<T>) {
+      return static_cast<size_t>(HashBytes(vector.Data(), vector.Size() * sizeof(T)));
+    } else {
+      uint64_t hash = HashMix(vector.Size(), kHashSecret[0]);
+      for (size_t i = 0; i < vector.Size(); ++i) {
+        hash = HashMix(hash ^ std::hash<T>()(vector[i]), kHashSecret[1]);
+      }
+      return static_cast<size_t>(hash);
+    }
+  }
+};
+
 #endif
@@ -0,0 +1,263 @@
+#ifndef VECTOR_PARALLEL_H_
+#define VECTOR_PARALLEL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "vector.h"
+
+// Opt-in parallel construction for Vector. Including this header requires linking with -pthread.
+
+// Fixed set of worker threads started once and reused by every Run(). The calling thread also takes
+// tasks, so a pool of n threads owns n - 1 workers. Run() from inside a task executes inline.
+class ParallelPool {
+ private:
+  std::mutex mutex_;
+  std::mutex run_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  Vector<std::thread> workers_;
+  const std::function<void(size_t)>* task_;
+  size_t task_count_;
+  size_t next_task_;
+  size_t finished_;
+  uint64_t generation_;
+  bool stop_;
+
+  static bool& InsideTask();
+  bool RunOne(std::unique_lock<std::mutex>&);
+  void WorkerLoop();
+
+ public:
+  explicit ParallelPool(size_t threads = 0);
+  ParallelPool(const ParallelPool&) = delete;
+  ParallelPool& operator=(const ParallelPool&) = delete;
+  ~ParallelPool();
+  size_t Threads() const noexcept;
+  void Run(size_t task_count, const std::function<void(size_t)>& task);
+  static ParallelPool& Global();
+};
+
+// Selects how element construction is split; threads == 0 uses every thread of the pool, and a null
+// pool means ParallelPool::Global().
+struct ExecutionPolicy {
+  size_t threads;
+  ParallelPool* pool = nullptr;
+};
+
+inline constexpr ExecutionPolicy kSequential{1};
+inline constexpr ExecutionPolicy kParallel{0};
+
+inline bool& ParallelPool::InsideTask() {
+  static thread_local bool inside = false;
+  return inside;
+}
+
+// threads == 0 starts one thread per hardware thread.
+inline ParallelPool::ParallelPool(size_t threads)
+    : task_(nullptr), task_count_(0), next_task_(0), finished_(0), generation_(0), stop_(false) {
+  if (threads == 0) {
+    threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  workers_.Reserve(threads - 1);
+  try {
+    for (size_t i = 1; i < threads; ++i) {
+      workers_.EmplaceBack([this] { WorkerLoop(); });
+    }
+  } catch (...) {
+    // Running with fewer workers is still correct.
+  }
+}
+
+inline ParallelPool::~ParallelPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+inline size_t ParallelPool::Threads() const noexcept {
+  return workers_.Size() + 1;
+}
+
+// Takes the next task of the current job, if any, and runs it with the lock released.
+inline bool ParallelPool::RunOne(std::unique_lock<std::mutex>& lock) {
+  if (next_task_ >= task_count_) {
+    return false;
+  }
+  size_t index = next_task_++;
+  const std::function<void(size_t)>& task = *task_;
+  lock.unlock();
+  task(index);
+  lock.lock();
+  if (++finished_ == task_count_) {
+    done_.notify_all();
+  }
+  return true;
+}
+
+inline void ParallelPool::WorkerLoop() {
+  InsideTask() = true;
+  uint64_t seen = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+    if (stop_) {
+      return;
+    }
+    seen = generation_;
+    while (RunOne(lock)) {
+    }
+  }
+}
+
+// Calls task(i) for every i in [0, task_count) and returns once all of them finished. task must not
+// throw.
+inline void ParallelPool::Run(size_t task_count, const std::function<void(size_t)>& task) {
+  if (task_count <= 1 || workers_.Empty() || InsideTask()) {
+    for (size_t i = 0; i < task_count; ++i) {
+      task(i);
+    }
+    return;
+  }
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_ = &task;
+  task_count_ = task_count;
+  next_task_ = 0;
+  finished_ = 0;
+  ++generation_;
+  wake_.notify_all();
+  InsideTask() = true;
+  while (RunOne(lock)) {
+  }
+  InsideTask() = false;
+  done_.wait(lock, [&] { return finished_ == task_count_; });
+  task_ = nullptr;
+}
+
+inline ParallelPool& ParallelPool::Global() {
+  static ParallelPool pool;
+  return pool;
+}
+
+constexpr size_t kParallelMinChunk = size_t(1) << 15;
+
+// Constructs vector1[0, size) with construct(ptr, index), split into chunks run on the policy's pool. If
+// any chunk throws, the chunks that completed are destroyed and the first exception is rethrown.
+template <typename T, class Construct>
+void ParallelConstructArray(T* vector1, size_t size, const ExecutionPolicy& policy, Construct construct) {
+  ParallelPool* pool = policy.pool;
+  size_t threads = 1;
+  size_t max_chunks = std::max<size_t>(1, size / kParallelMinChunk);
+  if (policy.threads != 1 && max_chunks > 1) {
+    if (pool == nullptr) {
+      pool = &ParallelPool::Global();
+    }
+    threads = std::min(policy.threads == 0 ? pool->Threads() : policy.threads, max_chunks);
+  }
+  size_t chunk = (size + threads - 1) / threads;
+  auto construct_chunk = [&](size_t index) {
+    size_t begin = std::min(size, index * chunk);
+    size_t end = std::min(size, begin + chunk);
+    size_t current = begin;
+    try {
+      for (; current < end; ++current) {
+        construct(vector1 + current, current);
+      }
+    } catch (...) {
+      for (size_t i = begin; i < current; ++i) {
+        vector1[i].~T();
+      }
+      throw;
+    }
+  };
+  if (threads <= 1) {
+    construct_chunk(0);
+    return;
+  }
+  Vector<std::exception_ptr> errors(threads);
+  pool->Run(threads, [&](size_t index) {
+    try {
+      construct_chunk(index);
+    } catch (...) {
+      errors[index] = std::current_exception();
+    }
+  });
+  std::exception_ptr error = nullptr;
+  for (size_t index = 0; index < threads; ++index) {
+    if (errors[index] != nullptr && error == nullptr) {
+      error = errors[index];
+    }
+  }
+  if (error != nullptr) {
+    for (size_t index = 0; index < threads; ++index) {
+      if (errors[index] == nullptr) {
+        size_t begin = std::min(size, index * chunk);
+        for (size_t i = begin; i < std::min(size, begin + chunk); ++i) {
+          vector1[i].~T();
+        }
+      }
+    }
+    std::rethrow_exception(error);
+  }
+}
+
+template <typename T, class Alloc, class Growth>
+void ParallelResize(Vector<T, Alloc, Growth>& vector, const ExecutionPolicy& policy, size_t new_size) {
+  if (vector.Size() >= new_size) {
+    vector.Resize(new_size);
+    return;
+  }
+  vector.AppendConstructed(new_size - vector.Size(), [&policy](T* ptr, size_t count) {
+    ParallelConstructArray(ptr, count, policy, [](T* element, size_t) { new (element) T(); });
+  });
+}
+
+template <typename T, class Alloc, class Growth>
+void ParallelResize(Vector<T, Alloc, Growth>& vector, const ExecutionPolicy& policy, size_t new_size,
+                    const T& value) {
+  if (vector.Size() >= new_size) {
+    vector.Resize(new_size);
+    return;
+  }
+  auto fill = [&vector, &policy, new_size](const T& source) {
+    vector.AppendConstructed(new_size - vector.Size(), [&policy, &source](T* ptr, size_t count) {
+      ParallelConstructArray(ptr, count, policy, [&source](T* element, size_t) { new (element) T(source); });
+    });
+  };
+  // value may live inside vector, so copy it before a reallocation can move it.
+  if (vector.Capacity() < new_size) {
+    T copy(value);
+    fill(copy);
+  } else {
+    fill(value);
+  }
+}
+
+template <typename T, class Alloc, class Growth, class It,
+          class = std::enable_if_t<std::is_base_of<std::random_access_iterator_tag,
+                                                   typename std::iterator_traits<It>::iterator_category>::value>>
+void ParallelAppend(Vector<T, Alloc, Growth>& vector, const ExecutionPolicy& policy, It it_begin, It it_end) {
+  size_t count = it_end - it_begin;
+  if (vector.Empty()) {
+    vector.Reserve(count);
+  }
+  vector.AppendConstructed(count, [&policy, &it_begin](T* ptr, size_t size) {
+    ParallelConstructArray(ptr, size, policy,
+                           [&it_begin](T* element, size_t index) { new (element) T(*std::next(it_begin, index)); });
+  });
+}
+
+#endif  // VECTOR_PARALLEL_H_
@@ -0,0 +1,109 @@
+#ifndef VECTOR_TELEMETRY_H_
+#define VECTOR_TELEMETRY_H_
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <typeinfo>
+
+// Per-element-type allocation and copy counters for Vector. Counting is off for every type; turn it
+// on for one with
+//   template <> struct VectorTelemetryEnabled<Widget> : std::true_type {};
+// before the first Vector<Widget> is used. Like any trait specialization it must be visible in every
+// translation unit that uses Vector<Widget>. Types that stay off get empty hooks and no record.
+// Printing the records lives in vector_telemetry_report.h.
+template <class T>
+struct VectorTelemetryEnabled : std::false_type {};
+
+template <class T>
+inline constexpr bool kVectorTelemetryEnabledV = VectorTelemetryEnabled<T>::value;
+
+struct VectorTelemetryRecord {
+  const char* type_name;
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> reallocations{0};
+  std::atomic<size_t> bytes_moved{0};
+  std::atomic<size_t> elements_copied{0};
+  std::atomic<size_t> peak_capacity{0};
+  VectorTelemetryRecord* next{nullptr};
+};
+
+class VectorTelemetry {
+ private:
+  static std::atomic<VectorTelemetryRecord*>& Head() {
+    static std::atomic<VectorTelemetryRecord*> head{nullptr};
+    return head;
+  }
+
+ public:
+  template <class T>
+  static VectorTelemetryRecord& Record() {
+    static VectorTelemetryRecord* record = [] {
+      auto created = new VectorTelemetryRecord;
+      created->type_name = typeid(T).name();
+      created->next = Head().load(std::memory_order_relaxed);
+      while (!Head().compare_exchange_weak(created->next, created, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+      }
+      return created;
+    }();
+    return *record;
+  }
+
+  // Records of every type counted so far, newest first, linked through next.
+  static VectorTelemetryRecord* First() noexcept {
+    return Head().load(std::memory_order_acquire);
+  }
+
+  static void Reset() {
+    for (auto record = First(); record != nullptr; record = record->next) {
+      record->allocations = 0;
+      record->reallocations = 0;
+      record->bytes_moved = 0;
+      record->elements_copied = 0;
+      record->peak_capacity = 0;
+    }
+  }
+};
+
+inline void VectorTelemetryUpdatePeak(VectorTelemetryRecord& record, size_t capacity) noexcept {
+  size_t peak = record.peak_capacity.load(std::memory_order_relaxed);
+  while (peak < capacity && !record.peak_capacity.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+  }
+}
+
+template <class T>
+void VectorTelemetryOnAllocate(size_t capacity) noexcept {
+  if constexpr (kVectorTelemetryEnabledV<T>) {
+    auto& record = VectorTelemetry::Record<T>();
+    record.allocations.fetch_add(1, std::memory_order_relaxed);
+    VectorTelemetryUpdatePeak(record, capacity);
+  }
+}
+
+template <class T>
+void VectorTelemetryOnReallocate(size_t old_capacity, size_t new_capacity) noexcept {
+  if constexpr (kVectorTelemetryEnabledV<T>) {
+    auto& record = VectorTelemetry::Record<T>();
+    if (old_capacity != 0) {
+      record.reallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    VectorTelemetryUpdatePeak(record, new_capacity);
+  }
+}
+
+template <class T>
+void VectorTelemetryOnMove(size_t count) noexcept {
+  if constexpr (kVectorTelemetryEnabledV<T>) {
+    VectorTelemetry::Record<T>().bytes_moved.fetch_add(count * sizeof(T), std::memory_order_relaxed);
+  }
+}
+
+template <class T>
+void VectorTelemetryOnCopy(size_t count) noexcept {
+  if constexpr (kVectorTelemetryEnabledV<T>) {
+    VectorTelemetry::Record<T>().elements_copied.fetch_add(count, std::memory_order_relaxed);
+  }
+}
+
+#endif
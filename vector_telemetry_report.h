@@ -0,0 +1,38 @@
+#ifndef VECTOR_TELEMETRY_REPORT_H_
+#define VECTOR_TELEMETRY_REPORT_H_
+
+#include <ostream>
+#include <string>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+#include "vector_telemetry.h"
+
+// Kept apart from vector_telemetry.h so that only code printing the counters pulls in streams,
+// strings and the demangler.
+inline std::string VectorTelemetryDemangle(const char* name) {
+#if __has_include(<cxxabi.h>)
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status == 0 && demangled != nullptr) {
+    std::string result(demangled);
+    std::free(demangled);
+    return result;
+  }
+#endif
+  return name;
+}
+
+// One line per counted element type.
+inline void VectorTelemetryDump(std::ostream& os) {
+  for (auto record = VectorTelemetry::First(); record != nullptr; record = record->next) {
+    os << VectorTelemetryDemangle(record->type_name) << ": allocations=" << record->allocations
+       << " reallocations=" << record->reallocations << " bytes_moved=" << record->bytes_moved
+       << " elements_copied=" << record->elements_copied << " peak_capacity=" << record->peak_capacity << '\n';
+  }
+}
+
+#endif
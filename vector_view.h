@@ -0,0 +1,130 @@
+#ifndef VECTOR_VIEW_H_
+#define VECTOR_VIEW_H_
+
+#include "vector.h"
+
+// Non-owning view of a contiguous run of T: a pointer and a length. VectorView<const T> is the
+// read-only slice. It binds to anything with Data() and Size(): Vector, SmallVector, MappedVector.
+template <typename T>
+class VectorView {
+ private:
+  using ValueT = std::remove_const_t<T>;
+  T* vector_;
+  size_t size_;
+
+  template <class Container>
+  static T* DataOf(Container& container) {
+    if constexpr (std::is_const_v<T>) {
+      return std::as_const(container).Data();
+    } else {
+      return container.Data();
+    }
+  }
+
+ public:
+  using Iterator = typename Vector<ValueT>::template common_iterator<std::is_const_v<T>>;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using Reference = T&;
+  using Pointer = T*;
+  using ValueType = ValueT;
+  using SizeType = size_t;
+
+  VectorView() noexcept : vector_(nullptr), size_(0) {
+  }
+
+  VectorView(T* data, size_t size) noexcept : vector_(data), size_(size) {
+  }
+
+  // A view of const T binds through the const Data(), which a read-only MappedVector allows; a
+  // mutable view of one throws MappedVectorError.
+  template <class Container,
+            class = std::enable_if_t<std::is_convertible_v<decltype(std::declval<Container&>().Data()), T*>>>
+  VectorView(Container& container)  // NOLINT
+      : vector_(DataOf(container)), size_(container.Size()) {
+  }
+
+  size_t Size() const noexcept {
+    return size_;
+  }
+
+  bool Empty() const noexcept {
+    return (size_ == 0);
+  }
+
+  T& operator[](size_t index) const {
+    return vector_[index];
+  }
+
+  T& At(size_t index) const {
+    if (index >= size_) {
+      throw VectorOutOfRange{};
+    }
+    return vector_[index];
+  }
+
+  T& Front() const noexcept {
+    return vector_[0];
+  }
+
+  T& Back() const noexcept {
+    return vector_[size_ - 1];
+  }
+
+  T* Data() const noexcept {
+    return vector_;
+  }
+
+  VectorView Subview(size_t offset, size_t count) const {
+    if (offset > size_) {
+      throw VectorOutOfRange{};
+    }
+    return VectorView(vector_ + offset, std::min(count, size_ - offset));
+  }
+
+  VectorView First(size_t count) const {
+    return Subview(0, count);
+  }
+
+  VectorView Last(size_t count) const {
+    return Subview(size_ - std::min(count, size_), count);
+  }
+
+  Iterator begin() const {  // NOLINT
+    return Iterator(vector_);
+  }
+
+  Iterator end() const {  // NOLINT
+    return Iterator(vector_ + size_);
+  }
+
+  ReverseIterator rbegin() const {  // NOLINT
+    return std::make_reverse_iterator(end());
+  }
+
+  ReverseIterator rend() const {  // NOLINT
+    return std::make_reverse_iterator(begin());
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const VectorView<T>& view1, const VectorView<U>& view2) {
+  if constexpr (std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>>) {
+    return ArraysEqual<std::remove_const_t<T>>(view1.Data(), view1.Size(), view2.Data(), view2.Size());
+  }
+  if (view1.Size() != view2.Size()) {
+    return false;
+  }
+  for (size_t i = 0; i < view1.Size(); ++i) {
+    if (view1[i] != view2[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const VectorView<T>& view1, const VectorView<U>& view2) {
+  return !(view1 == view2);
+}
+
+#endif